@@ -7,16 +7,24 @@ const napi = require(path.resolve(__dirname, 'build', 'Release', 'napi.node'));
 const nobind = require(path.resolve(__dirname, 'build', 'Release', 'nobind.node'));
 const swig = require(path.resolve(__dirname, 'build', 'Release', 'swig.node'));
 
-const len = 16384;
-const Data = crypto.randomBytes(len / 2).toString('hex');
+function suite(len) {
+  const Data = crypto.randomBytes(len / 2).toString('hex');
 
-module.exports = function () {
   return b.suite(
-    `Global function strlen`,
+    `Global function strlen (${len} bytes)`,
 
     b.add('nobind', () => {
       assert(nobind.strlen(Data) === len, 'Data error');
     }),
+    b.add('nobind std::string_view', () => {
+      assert(nobind.strlenView(Data) === len, 'Data error');
+    }),
+    b.add('nobind Latin-1', () => {
+      assert(nobind.strlenLatin1(Data) === len, 'Data error');
+    }),
+    b.add('nobind std::u16string', () => {
+      assert(nobind.strlenU16(Data) === len, 'Data error');
+    }),
     b.add('napi', () => {
       assert(napi.strlen(Data) === len, 'Data error');
     }),
@@ -26,4 +34,10 @@ module.exports = function () {
     b.cycle(),
     b.complete()
   );
+}
+
+module.exports = async function () {
+  await suite(16);
+  await suite(16384);
+  await suite(1024 * 1024);
 };
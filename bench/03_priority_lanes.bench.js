@@ -0,0 +1,55 @@
+const path = require('path');
+const crypto = require('crypto');
+const assert = require('assert');
+const { performance } = require('perf_hooks');
+
+const nobind = require(path.resolve(__dirname, 'build', 'Release', 'nobind.node'));
+
+const len = 16384;
+const Data = crypto.randomBytes(len / 2).toString('hex');
+// Each bulk job takes a few milliseconds
+const rounds = 200;
+const bulkInFlight = 64;
+const lookupInterval = 5;
+const duration = 3000;
+
+function percentile(sorted, p) {
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+// Keeps bulkInFlight bulk jobs in flight and measures the latency of periodic lookups
+async function mixedLoad(name, bulk, lookup) {
+  const latencies = [];
+  let bulkDone = 0;
+  let running = true;
+  const feeders = Array.from({ length: bulkInFlight }, async () => {
+    while (running) {
+      await bulk(Data, rounds);
+      bulkDone++;
+    }
+  });
+
+  const start = performance.now();
+  while (performance.now() - start < duration) {
+    const t0 = performance.now();
+    assert(await lookup(Data) === len, 'Data error');
+    latencies.push(performance.now() - t0);
+    await new Promise((res) => setTimeout(res, lookupInterval));
+  }
+  const elapsed = performance.now() - start;
+  running = false;
+  await Promise.all(feeders);
+
+  latencies.sort((a, b) => a - b);
+  console.log(`  ${name}: ${latencies.length} lookups, ` +
+    `p50 ${percentile(latencies, 0.5).toFixed(2)} ms, ` +
+    `p99 ${percentile(latencies, 0.99).toFixed(2)} ms, ` +
+    `max ${latencies[latencies.length - 1].toFixed(2)} ms, ` +
+    `bulk ${(bulkDone * 1000 / elapsed).toFixed(0)} jobs/s`);
+}
+
+module.exports = async function () {
+  console.log(`Mixed load, lookup latency behind ${bulkInFlight} bulk jobs in flight`);
+  await mixedLoad('FIFO (ReturnAsync)', nobind.hashAsync, nobind.strlenAsync);
+  await mixedLoad('high/background lanes (ReturnPriority)', nobind.hashBackground, nobind.strlenHigh);
+};
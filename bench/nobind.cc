@@ -7,5 +7,11 @@ NOBIND_MODULE(bench_nobind_string, m) {
     .cons<std::string &>()
     .def<&String::Len>("length");
   m.def<&Strlen>("strlen");
+  m.def<&StrlenView>("strlenView");
+  m.def<&StrlenView, Nobind::ReturnDefault, Nobind::ArgLatin1<0>>("strlenLatin1");
+  m.def<&StrlenU16>("strlenU16");
   m.def<&Strlen, Nobind::ReturnAsync>("strlenAsync");
+  m.def<&Strlen, Nobind::ReturnPriority<Nobind::PriorityHigh>>("strlenHigh");
+  m.def<&Hash, Nobind::ReturnAsync>("hashAsync");
+  m.def<&Hash, Nobind::ReturnPriority<Nobind::PriorityBackground>>("hashBackground");
 }
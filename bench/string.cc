@@ -1,6 +1,15 @@
 #include "string.h"
 
 size_t Strlen(const std::string &s) { return s.size(); }
+size_t StrlenView(std::string_view s) { return s.size(); }
+size_t StrlenU16(const std::u16string &s) { return s.size(); }
+uint32_t Hash(const std::string &s, int32_t rounds) {
+  uint32_t h = 2166136261u;
+  for (int32_t i = 0; i < rounds; i++)
+    for (char c : s)
+      h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+  return h;
+}
 
 String::String(const std::string &init) : s(init){};
 size_t String::Len() { return s.size(); }
@@ -1,6 +1,12 @@
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 size_t Strlen(const std::string &s);
+size_t StrlenView(std::string_view s);
+size_t StrlenU16(const std::u16string &s);
+// A slow function, FNV-1a hash of the string repeated rounds times
+uint32_t Hash(const std::string &s, int32_t rounds);
 
 class String {
   std::string s;
@@ -57,6 +57,13 @@ public:
 
 #include <nobind.h>
 
+// The property names are created only once per environment
+constexpr char key_name[] = "name";
+constexpr char key_eyes[] = "eyes";
+constexpr char key_fangs[] = "fangs";
+constexpr char key_feature[] = "feature";
+constexpr char key_greeter[] = "greeter";
+
 // Implement the parsing of the JS struct here
 Nobind::TypemapOverrides::FromJS<MonsterDefinition>::FromJS(Napi::Value val) {
   Napi::Env env{val.Env()};
@@ -66,17 +73,17 @@ Nobind::TypemapOverrides::FromJS<MonsterDefinition>::FromJS(Napi::Value val) {
   }
   Napi::Object obj = val.ToObject();
 
-  val_.name = Nobind::Typemap::FromJS<std::string>(obj.Get("name")).Get();
-  val_.eyes = Nobind::Typemap::FromJS<unsigned>(obj.Get("eyes")).Get();
+  val_.name = Nobind::Typemap::FromJS<std::string>(obj.Get(Nobind::PropertyKey<key_name>(env))).Get();
+  val_.eyes = Nobind::Typemap::FromJS<unsigned>(obj.Get(Nobind::PropertyKey<key_eyes>(env))).Get();
 
-  Napi::Value js_fangs = obj.Get("fangs");
+  Napi::Value js_fangs = obj.Get(Nobind::PropertyKey<key_fangs>(env));
   if (js_fangs.IsUndefined()) {
     val_.fangs = false;
   } else {
     val_.fangs = Nobind::Typemap::FromJS<bool>(js_fangs).Get();
   }
 
-  Napi::Value js_feature = obj.Get("feature");
+  Napi::Value js_feature = obj.Get(Nobind::PropertyKey<key_feature>(env));
   std::string str_feature = Nobind::Typemap::FromJS<std::string>(js_feature).Get();
   if (str_feature == "claws")
     val_.feature = MonsterDefinition::CLAWS;
@@ -85,18 +92,20 @@ Nobind::TypemapOverrides::FromJS<MonsterDefinition>::FromJS(Napi::Value val) {
   else
     throw Napi::TypeError::New(env, std::string{"Invalid feature: "} + str_feature);
 
-  val_.greeter = Nobind::Typemap::FromJS<Hello>(obj.Get("greeter")).Get();
+  val_.greeter = Nobind::Typemap::FromJS<Hello>(obj.Get(Nobind::PropertyKey<key_greeter>(env))).Get();
 }
 
 // Implement the construction of the JS struct here
 Napi::Value Nobind::TypemapOverrides::ToJS<MonsterDefinition>::Get() {
   Napi::EscapableHandleScope scope{env_};
   Napi::Object result = Napi::Object::New(env_);
-  result.Set("name", Nobind::Typemap::ToJS<std::string>(env_, val_.name).Get());
-  result.Set("eyes", Nobind::Typemap::ToJS<unsigned>(env_, val_.eyes).Get());
-  result.Set("fangs", Nobind::Typemap::ToJS<bool>(env_, val_.fangs).Get());
+  result.Set(Nobind::PropertyKey<key_name>(env_), Nobind::Typemap::ToJS<std::string>(env_, val_.name).Get());
+  result.Set(Nobind::PropertyKey<key_eyes>(env_), Nobind::Typemap::ToJS<unsigned>(env_, val_.eyes).Get());
+  result.Set(Nobind::PropertyKey<key_fangs>(env_), Nobind::Typemap::ToJS<bool>(env_, val_.fangs).Get());
   std::string feature = val_.feature == MonsterDefinition::CLAWS ? "claws" : "horn";
-  result.Set("feature", Nobind::Typemap::ToJS<std::string>(env_, feature).Get());
-  result.Set("greeter", Nobind::Typemap::ToJS<Hello>(env_, val_.greeter).Get());
+  // There are only two possible values, reuse the same JS strings
+  result.Set(Nobind::PropertyKey<key_feature>(env_),
+             Nobind::Typemap::ToJS<std::string, Nobind::ReturnInterned>(env_, feature).Get());
+  result.Set(Nobind::PropertyKey<key_greeter>(env_), Nobind::Typemap::ToJS<Hello>(env_, val_.greeter).Get());
   return scope.Escape(result);
 }
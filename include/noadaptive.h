@@ -0,0 +1,122 @@
+#pragma once
+#include <nonapi.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <noattributes.h>
+#include <nodebug.h>
+
+// Calls of ReturnAdaptive bindings estimated to take less than this
+// number of microseconds run on the main thread
+#ifndef NOBIND_ADAPTIVE_THRESHOLD
+#define NOBIND_ADAPTIVE_THRESHOLD 50
+#endif
+
+#ifndef NOBIND_ADAPTIVE_PROP
+#define NOBIND_ADAPTIVE_PROP "__adaptive"
+#endif
+
+namespace Nobind {
+
+// Adaptive sync/async dispatch
+//
+// Every ReturnAdaptive binding keeps a moving average of the execution time
+// of its C++ function. A call is run inline on the main thread, settling the
+// Promise before returning, when the average is below NOBIND_ADAPTIVE_THRESHOLD
+// and it is queued on the thread pool otherwise. Both paths measure the same
+// thing - the C++ call itself - so the estimate does not depend on the decision.
+// The first call of a binding is always queued.
+class AdaptiveStats {
+  // Exponential moving average in nanoseconds, each new sample weighs 1/8
+  std::atomic<uint64_t> estimate_;
+  std::atomic<uint64_t> samples_;
+  std::atomic<uint64_t> inline_;
+  std::atomic<uint64_t> offloaded_;
+
+public:
+  AdaptiveStats() : estimate_(0), samples_(0), inline_(0), offloaded_(0) {}
+
+  // Called on the main thread before every call
+  bool ShouldRunInline() {
+    bool r = samples_.load(std::memory_order_relaxed) > 0 &&
+             estimate_.load(std::memory_order_relaxed) < NOBIND_ADAPTIVE_THRESHOLD * 1000;
+    (r ? inline_ : offloaded_).fetch_add(1, std::memory_order_relaxed);
+    return r;
+  }
+
+  // Called on the thread that ran the call, when several calls finish
+  // at the same time, only one of them updates the estimate
+  void Record(uint64_t ns) {
+    uint64_t old = estimate_.load(std::memory_order_relaxed);
+    uint64_t avg = samples_.fetch_add(1, std::memory_order_relaxed) == 0 ? ns : old - old / 8 + ns / 8;
+    estimate_.compare_exchange_strong(old, avg, std::memory_order_relaxed);
+  }
+
+  Napi::Object ToJS(Napi::Env env) const {
+    Napi::Object r = Napi::Object::New(env);
+    r.Set("estimate", Napi::Number::New(env, estimate_.load(std::memory_order_relaxed) / 1000.0));
+    r.Set("samples", Napi::Number::New(env, static_cast<double>(samples_.load(std::memory_order_relaxed))));
+    r.Set("inline", Napi::Number::New(env, static_cast<double>(inline_.load(std::memory_order_relaxed))));
+    r.Set("offloaded", Napi::Number::New(env, static_cast<double>(offloaded_.load(std::memory_order_relaxed))));
+    return r;
+  }
+};
+
+// The statistics are shared by all the bindings of the same C++ function
+template <auto FUNC> AdaptiveStats &Adaptive() {
+  static AdaptiveStats stats;
+  return stats;
+}
+
+// Measures the C++ call, does nothing when the binding is not adaptive
+template <const ReturnAttribute &RETATTR, auto FUNC> class AdaptiveTimer {
+  std::chrono::steady_clock::time_point start_;
+
+public:
+  AdaptiveTimer() {
+    if constexpr (RETATTR.isAdaptive())
+      start_ = std::chrono::steady_clock::now();
+  }
+  ~AdaptiveTimer() {
+    if constexpr (RETATTR.isAdaptive()) {
+      auto elapsed = std::chrono::steady_clock::now() - start_;
+      Adaptive<FUNC>().Record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+  }
+};
+
+// Run the tasklet inline or queue it, directly or through the priority lanes
+template <const ReturnAttribute &RETATTR, auto FUNC, typename TASKLET>
+NOBIND_INLINE void AdaptiveQueue(TASKLET *tasklet) {
+  if constexpr (RETATTR.isAdaptive()) {
+    if (Adaptive<FUNC>().ShouldRunInline()) {
+      tasklet->RunInline();
+      delete tasklet;
+      return;
+    }
+  }
+  if constexpr (RETATTR.isPrioritized()) {
+    tasklet->Prioritize();
+  } else {
+    tasklet->Queue();
+  }
+}
+
+// The per-environment list of the adaptive bindings, for NOBIND_ADAPTIVE_PROP
+using AdaptiveBindings = std::vector<std::pair<std::string, AdaptiveStats *>>;
+
+inline Napi::Value AdaptiveStatsGetter(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  Napi::Object r = Napi::Object::New(env);
+  auto bindings = static_cast<AdaptiveBindings *>(info.Data());
+  for (const auto &binding : *bindings)
+    r.Set(binding.first, binding.second->ToJS(env));
+  return r;
+}
+
+} // namespace Nobind
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <initializer_list>
 
 namespace Nobind {
 
@@ -32,15 +34,35 @@ constexpr PropertyAttribute ReadWrite = PropertyAttribute();
 class ReturnAttribute : public Attribute {
 public:
   enum Return { Shared = 0x1, Owned = 0x2, Nested = 0x40, Copy = 0x80 };
-  enum Execution { Sync = 0x4, Async = 0x8 };
+  enum Execution {
+    Sync = 0x4,
+    Async = 0x8,
+    Batch = 0x800,
+    Parallel = 0x1000,
+    Adaptive = 0x8000,
+    Cancellable = 0x100000
+  };
   enum Null { Allowed = 0x10, Forbidden = 0x20 };
+  enum Encoding { Latin1 = 0x100 };
+  enum Caching { Interned = 0x200, Memoized = 0x10000 };
+  enum Layout { StructOfArrays = 0x400 };
+  enum Delivery { Sliced = 0x2000, Streamed = 0x4000 };
+  enum Overflow { Queue = 0x20000, Reject = 0x40000, DropOldest = 0x80000 };
+  enum Priority { High = 0x200000, Normal = 0x400000, Background = 0x800000 };
+  static constexpr size_t Lanes = 3;
 
-  constexpr ReturnAttribute() : flags(0) {}
-  constexpr ReturnAttribute(Return v) : flags(v) {}
-  constexpr ReturnAttribute(Execution v) : flags(v) {}
-  constexpr ReturnAttribute(Null v) : flags(v) {}
+  constexpr ReturnAttribute() : flags(0), limit(0) {}
+  constexpr ReturnAttribute(Return v) : flags(v), limit(0) {}
+  constexpr ReturnAttribute(Execution v) : flags(v), limit(0) {}
+  constexpr ReturnAttribute(Null v) : flags(v), limit(0) {}
+  constexpr ReturnAttribute(Encoding v) : flags(v), limit(0) {}
+  constexpr ReturnAttribute(Caching v) : flags(v), limit(0) {}
+  constexpr ReturnAttribute(Layout v) : flags(v), limit(0) {}
+  constexpr ReturnAttribute(Delivery v) : flags(v), limit(0) {}
+  constexpr ReturnAttribute(Priority v) : flags(v), limit(0) {}
+  constexpr ReturnAttribute(Overflow v, size_t max) : flags(v), limit(max) {}
   constexpr ReturnAttribute operator|(const ReturnAttribute &other) const {
-    return ReturnAttribute(flags | other.flags);
+    return ReturnAttribute(flags | other.flags, limit > other.limit ? limit : other.limit);
   }
   constexpr bool isShared() const { return (flags & Shared) == Shared; }
   constexpr bool isOwned() const { return (flags & Owned) == Owned; }
@@ -49,6 +71,26 @@ public:
   constexpr bool isReturnNullAccept() const { return (flags & Allowed) == Allowed; }
   constexpr bool isReturnNullThrow() const { return (flags & Forbidden) == Forbidden; }
   constexpr bool isAsync() const { return (flags & Async) == Async; }
+  constexpr bool isBatch() const { return (flags & Batch) == Batch; }
+  constexpr bool isParallel() const { return (flags & Parallel) == Parallel; }
+  constexpr bool isAdaptive() const { return (flags & Adaptive) == Adaptive; }
+  constexpr bool isCancellable() const { return (flags & Cancellable) == Cancellable; }
+  constexpr bool isLatin1() const { return (flags & Latin1) == Latin1; }
+  constexpr bool isInterned() const { return (flags & Interned) == Interned; }
+  constexpr bool isMemoized() const { return (flags & Memoized) == Memoized; }
+  constexpr bool isStructOfArrays() const { return (flags & StructOfArrays) == StructOfArrays; }
+  constexpr bool isSliced() const { return (flags & Sliced) == Sliced; }
+  constexpr bool isStreamed() const { return (flags & Streamed) == Streamed; }
+  constexpr bool isLimited() const { return limit > 0; }
+  constexpr size_t Limit() const { return limit; }
+  constexpr Overflow Policy() const {
+    return (flags & Reject) == Reject ? Reject : (flags & DropOldest) == DropOldest ? DropOldest : Queue;
+  }
+  constexpr bool isPrioritized() const { return (flags & (High | Normal | Background)) != 0; }
+  // The dispatcher lane, 0 is the highest
+  constexpr size_t Lane() const { return (flags & High) == High ? 0 : (flags & Normal) == Normal ? 1 : 2; }
+  // The attributes of the elements of a container (without the delivery mode of the container)
+  constexpr ReturnAttribute Elements() const { return ReturnAttribute(flags & ~(Sliced | Streamed), limit); }
   template <bool DEFAULT> constexpr bool ShouldOwn() const {
     if (isShared())
       return false;
@@ -62,8 +104,10 @@ public:
   }
 
 private:
-  constexpr ReturnAttribute(int v) : flags(v) {}
+  constexpr ReturnAttribute(int v, size_t max = 0) : flags(v), limit(max) {}
   int flags;
+  // The maximum number of calls in flight
+  size_t limit;
 };
 
 /**
@@ -107,6 +151,93 @@ constexpr ReturnAttribute ReturnAsync = ReturnAttribute(ReturnAttribute::Async);
  */
 template <const ReturnAttribute &RET> constexpr ReturnAttribute RetWithAsync = Nobind::ReturnAsync | RET;
 
+/**
+ * The method will return a Promise and it will run either on the main thread
+ * or in a background thread depending on its measured execution time
+ */
+constexpr ReturnAttribute ReturnAdaptive = ReturnAsync | ReturnAttribute(ReturnAttribute::Adaptive);
+
+/**
+ * The method will be asynchronous and it will accept an optional AbortSignal
+ * as its last argument
+ */
+constexpr ReturnAttribute ReturnCancellable = ReturnAsync | ReturnAttribute(ReturnAttribute::Cancellable);
+
+/**
+ * The function will be called once for each element of its arguments which are
+ * arrays of the same length, the results are returned in an array
+ */
+constexpr ReturnAttribute ReturnBatch = ReturnAttribute(ReturnAttribute::Batch);
+
+/**
+ * The function will be called once for each element of its arguments which are
+ * arrays of the same length, the elements are split in chunks running in background
+ * threads and it returns a Promise resolved with the array of the results
+ */
+constexpr ReturnAttribute ReturnParallel = ReturnAttribute(ReturnAttribute::Parallel);
+
+/**
+ * The method will be asynchronous and its returned container will be converted
+ * to a JS array in slices, yielding to the event loop between the slices
+ */
+constexpr ReturnAttribute ReturnSliced = ReturnAsync | ReturnAttribute(ReturnAttribute::Sliced);
+
+/**
+ * The method will be asynchronous and it will return an async iterator over
+ * its returned container, the elements are converted when they are iterated
+ */
+constexpr ReturnAttribute ReturnStreamed = ReturnAsync | ReturnAttribute(ReturnAttribute::Streamed);
+
+/**
+ * constexpr template to get the attributes of the elements of a container
+ */
+template <const ReturnAttribute &RET> constexpr ReturnAttribute RetElements = RET.Elements();
+
+/**
+ * The excess calls of a ReturnLimit method wait in a queue (this is the default)
+ */
+constexpr ReturnAttribute::Overflow LimitQueue = ReturnAttribute::Queue;
+
+/**
+ * The excess calls of a ReturnLimit method are rejected
+ */
+constexpr ReturnAttribute::Overflow LimitReject = ReturnAttribute::Reject;
+
+/**
+ * The excess calls of a ReturnLimit method wait in a queue of at most MAX calls,
+ * the oldest waiting call is rejected when it is full
+ */
+constexpr ReturnAttribute::Overflow LimitDropOldest = ReturnAttribute::DropOldest;
+
+/**
+ * The method will be asynchronous and it will have at most MAX calls
+ * in flight, the excess calls are handled according to POLICY
+ */
+template <size_t MAX, ReturnAttribute::Overflow POLICY = LimitQueue>
+constexpr ReturnAttribute ReturnLimit = ReturnAsync | ReturnAttribute(POLICY, MAX);
+
+/**
+ * The calls of a ReturnPriority method are dispatched before all other waiting calls
+ */
+constexpr ReturnAttribute::Priority PriorityHigh = ReturnAttribute::High;
+
+/**
+ * The calls of a ReturnPriority method are dispatched after the high priority calls
+ */
+constexpr ReturnAttribute::Priority PriorityNormal = ReturnAttribute::Normal;
+
+/**
+ * The calls of a ReturnPriority method are dispatched when no other calls are waiting
+ */
+constexpr ReturnAttribute::Priority PriorityBackground = ReturnAttribute::Background;
+
+/**
+ * The method will be asynchronous and its calls will wait in the PRIORITY lane
+ * of the nobind17 dispatcher before being queued in the thread pool
+ */
+template <ReturnAttribute::Priority PRIORITY>
+constexpr ReturnAttribute ReturnPriority = ReturnAsync | ReturnAttribute(PRIORITY);
+
 /**
  * This method can return nullptr without raising an exception
  */
@@ -117,9 +248,119 @@ constexpr ReturnAttribute ReturnNullAccept = ReturnAttribute(ReturnAttribute::Al
  */
 constexpr ReturnAttribute ReturnNullThrow = ReturnAttribute(ReturnAttribute::Forbidden);
 
+/**
+ * The returned string is encoded in Latin-1 instead of UTF-8
+ */
+constexpr ReturnAttribute ReturnLatin1 = ReturnAttribute(ReturnAttribute::Latin1);
+
+/**
+ * The returned string will be interned, repeated returns of the same
+ * string will reuse the same JS string
+ */
+constexpr ReturnAttribute ReturnInterned = ReturnAttribute(ReturnAttribute::Interned);
+
+/**
+ * The results of the function will be cached in a bounded LRU cache indexed
+ * by its arguments, valid only for pure functions and static methods
+ */
+constexpr ReturnAttribute ReturnMemoized = ReturnAttribute(ReturnAttribute::Memoized);
+
+/**
+ * The returned vector of reflected structs will be transposed
+ * to an object of TypedArrays, one for each field
+ */
+constexpr ReturnAttribute ReturnStructOfArrays = ReturnAttribute(ReturnAttribute::StructOfArrays);
+
 class ArgumentAttribute : public Attribute {
 public:
-  constexpr ArgumentAttribute() {}
+  enum Direction { Output = 0x1 };
+  enum Checking { Coerce = 0x2, Unchecked = 0x4 };
+  enum Encoding { Latin1 = 0x8 };
+  enum Layout { StructOfArrays = 0x10 };
+  static constexpr size_t MaxArguments = 16;
+
+  constexpr ArgumentAttribute() : flags{} {}
+  constexpr ArgumentAttribute(Direction v, std::initializer_list<size_t> args) : flags{} {
+    for (size_t arg : args)
+      flags[arg] |= v;
+  }
+  constexpr ArgumentAttribute(Checking v, std::initializer_list<size_t> args) : flags{} {
+    for (size_t arg : args)
+      flags[arg] |= v;
+  }
+  constexpr ArgumentAttribute(Encoding v, std::initializer_list<size_t> args) : flags{} {
+    for (size_t arg : args)
+      flags[arg] |= v;
+  }
+  constexpr ArgumentAttribute(Layout v, std::initializer_list<size_t> args) : flags{} {
+    for (size_t arg : args)
+      flags[arg] |= v;
+  }
+  constexpr ArgumentAttribute operator|(const ArgumentAttribute &other) const {
+    ArgumentAttribute r;
+    for (size_t i = 0; i < MaxArguments; i++)
+      r.flags[i] = flags[i] | other.flags[i];
+    return r;
+  }
+  constexpr bool isOutput(size_t arg) const { return arg < MaxArguments && (flags[arg] & Output) == Output; }
+  constexpr bool isCoerce(size_t arg) const { return arg < MaxArguments && (flags[arg] & Coerce) == Coerce; }
+  constexpr bool isUnchecked(size_t arg) const { return arg < MaxArguments && (flags[arg] & Unchecked) == Unchecked; }
+  constexpr bool isLatin1(size_t arg) const { return arg < MaxArguments && (flags[arg] & Latin1) == Latin1; }
+  constexpr bool isStructOfArrays(size_t arg) const {
+    return arg < MaxArguments && (flags[arg] & StructOfArrays) == StructOfArrays;
+  }
+  constexpr bool hasOutput(size_t first, size_t length) const {
+    for (size_t i = first; i < first + length; i++)
+      if (isOutput(i))
+        return true;
+    return false;
+  }
+
+private:
+  int flags[MaxArguments];
 };
 
+/**
+ * All arguments are regular input arguments (this is the default)
+ */
+constexpr ArgumentAttribute ArgumentDefault = ArgumentAttribute();
+
+/**
+ * The arguments at these positions (starting from 0) are output arguments,
+ * they are allocated by nobind17 and returned to JS instead of being expected from JS
+ */
+template <size_t... I> constexpr ArgumentAttribute ArgOutput = ArgumentAttribute(ArgumentAttribute::Output, {I...});
+
+/**
+ * The arguments at these positions will be converted with the JS semantics
+ * (ie Number(x) or Boolean(x)) instead of throwing when they have the wrong type
+ */
+template <size_t... I> constexpr ArgumentAttribute ArgCoerce = ArgumentAttribute(ArgumentAttribute::Coerce, {I...});
+
+/**
+ * The arguments at these positions will be converted with a single Node-API call
+ * that relies on the returned status to detect values of the wrong type
+ */
+template <size_t... I>
+constexpr ArgumentAttribute ArgUnchecked = ArgumentAttribute(ArgumentAttribute::Unchecked, {I...});
+
+/**
+ * constexpr template to add ArgUnchecked for all the arguments to an ArgumentAttribute
+ */
+template <const ArgumentAttribute &ARG>
+constexpr ArgumentAttribute ArgWithUnchecked = ARG | ArgUnchecked<0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15>;
+
+/**
+ * The string arguments at these positions will be encoded in Latin-1 instead of UTF-8,
+ * characters outside of the Latin-1 range are truncated
+ */
+template <size_t... I> constexpr ArgumentAttribute ArgLatin1 = ArgumentAttribute(ArgumentAttribute::Latin1, {I...});
+
+/**
+ * The vectors of reflected structs at these positions will be constructed
+ * from an object of TypedArrays, one for each field
+ */
+template <size_t... I>
+constexpr ArgumentAttribute ArgStructOfArrays = ArgumentAttribute(ArgumentAttribute::StructOfArrays, {I...});
+
 } // namespace Nobind
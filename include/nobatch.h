@@ -0,0 +1,350 @@
+#pragma once
+#include <nodebug.h>
+#include <nonapi.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <noattributes.h>
+#include <notypedarray.h>
+#include <notypes.h>
+
+namespace Nobind {
+
+// Batch calls
+//
+// A function bound with ReturnBatch receives one array for each of its arguments
+// and it is called once for every element, the arrays must have the same length.
+// Number arguments can be passed as TypedArrays of the matching type which are
+// read without any Node-API call. Functions returning numbers return a TypedArray,
+// the other functions return an array.
+
+// A number stored in a batch column, it has the same interface as a typemap
+template <typename T> class BatchValue {
+  T val_;
+
+public:
+  NOBIND_INLINE explicit BatchValue(T val) : val_(val) {}
+  NOBIND_INLINE T Get() { return val_; }
+};
+
+// A column of the arguments of a batch call, a JS array or a TypedArray
+template <typename TM, typename T> class BatchColumn {
+  using U = std::remove_cv_t<std::remove_reference_t<T>>;
+  static constexpr bool number = std::is_arithmetic_v<U>;
+  Napi::Object array_;
+  const U *data_;
+  size_t length_;
+
+public:
+  NOBIND_INLINE explicit BatchColumn(const Napi::Value &val) : data_(nullptr) {
+    if (val.IsTypedArray()) {
+      Napi::TypedArray typed = val.As<Napi::TypedArray>();
+      length_ = typed.ElementLength();
+      if constexpr (IsTypedArrayElement_v<U>) {
+        if (typed.TypedArrayType() == TypedArrayTypeOf<U>())
+          data_ = reinterpret_cast<const U *>(static_cast<uint8_t *>(typed.ArrayBuffer().Data()) + typed.ByteOffset());
+      }
+    } else if (val.IsArray()) {
+      length_ = val.As<Napi::Array>().Length();
+    } else {
+      throw Napi::TypeError::New(val.Env(), "Expected an array or a TypedArray");
+    }
+    array_ = val.ToObject();
+  }
+
+  NOBIND_INLINE size_t Length() const { return length_; }
+
+  // The typemap of the element at i (parallel calls construct it in deferred mode)
+  template <bool DEFERRED = false> NOBIND_INLINE auto Element(size_t i) {
+    if constexpr (number) {
+      // Numbers do not need their typemap once converted
+      if (data_ != nullptr)
+        return BatchValue<U>(data_[i]);
+      return BatchValue<U>(TM(array_.Get(static_cast<uint32_t>(i))).Get());
+    } else {
+      return FromJSTypemapValue<TM, DEFERRED>(array_.Get(static_cast<uint32_t>(i)));
+    }
+  }
+};
+
+// Construct the columns of all the arguments of a batch call and check their lengths
+template <const ArgumentAttribute &ARGATTR, typename... ARGS, size_t... I>
+NOBIND_INLINE auto BatchColumnsAll(const Napi::CallbackInfo &info, size_t &length, std::index_sequence<I...>) {
+  static_assert(sizeof...(ARGS) > 0, "Batch calls require at least one argument");
+  static_assert(FromJSArgsLayout<ARGATTR, ARGS...>::Outputs() == 0, "Batch calls cannot have output arguments");
+  static_assert(((FromJSArgsLayout<ARGATTR, ARGS...>::Span(I) == 1) && ...),
+                "Batch calls cannot use multi-argument typemaps");
+  static_assert(((FromJSTypemapInputs<FromJSArg_t<I, ARGATTR, ARGS...>>() == 1) && ...),
+                "Batch calls cannot use typemaps with multiple inputs");
+  CheckArgLength(info.Env(), sizeof...(ARGS), info.Length());
+
+  std::tuple<BatchColumn<FromJSArg_t<I, ARGATTR, ARGS...>, ArgAt_t<I, ARGS...>>...> columns{
+      BatchColumn<FromJSArg_t<I, ARGATTR, ARGS...>, ArgAt_t<I, ARGS...>>(info[I])...};
+  length = std::get<0>(columns).Length();
+  if (((std::get<I>(columns).Length() != length) || ...)) {
+    throw Napi::RangeError::New(info.Env(), "All arguments must have the same length");
+  }
+  return columns;
+}
+
+// Create the TypedArray holding the results of a batch call
+template <typename R> NOBIND_INLINE Napi::Value BatchTypedArray(Napi::Env env, size_t length, R *&output) {
+  napi_value buffer, typed;
+  if (napi_create_arraybuffer(env, length * sizeof(R), reinterpret_cast<void **>(&output), &buffer) != napi_ok ||
+      napi_create_typedarray(env, TypedArrayTypeOf<R>(), length, buffer, 0, &typed) != napi_ok) {
+    throw Napi::Error::New(env, "Failed to create a TypedArray");
+  }
+  return Napi::Value(env, typed);
+}
+
+// Call a function over all the elements of its arguments
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          typename CALL, size_t... I>
+NOBIND_INLINE Napi::Value BatchCall(const Napi::CallbackInfo &info, CALL call, std::index_sequence<I...>) {
+  static_assert(!RETATTR.isAsync(), "Batch calls cannot be asynchronous");
+  static_assert(!RETATTR.isMemoized(), "Batch calls cannot be memoized");
+  Napi::Env env = info.Env();
+  size_t length;
+  auto columns = BatchColumnsAll<ARGATTR, ARGS...>(info, length, std::index_sequence<I...>{});
+
+  using R = std::remove_cv_t<RETURN>;
+  Napi::Value result;
+  R *output = nullptr;
+  if constexpr (std::is_void_v<R>) {
+    result = env.Undefined();
+  } else if constexpr (IsTypedArrayElement_v<R>) {
+    result = BatchTypedArray<R>(env, length, output);
+  } else {
+    result = Napi::Array::New(env, length);
+  }
+
+  for (size_t i = 0; i < length; i++) {
+    // Every element creates its own handles, release them before moving to the next one
+    Napi::HandleScope scope(env);
+    // Braced initialization guarantees the evaluation order
+    std::tuple<decltype(std::get<I>(columns).Element(i))...> args{std::get<I>(columns).Element(i)...};
+#ifndef NOBIND_NO_ASYNC_LOCKING
+    [[maybe_unused]] std::tuple<FromJSTypemapLockGuard<std::tuple_element_t<I, decltype(args)>>...> lock_guards{
+        std::get<I>(args)...};
+#endif
+    if constexpr (std::is_void_v<R>) {
+      call(std::get<I>(args).Get()...);
+    } else if constexpr (IsTypedArrayElement_v<R>) {
+      output[i] = call(std::get<I>(args).Get()...);
+    } else {
+      RETURN r = call(std::get<I>(args).Get()...);
+      result.ToObject().Set(static_cast<uint32_t>(i), ToJS_t<RETURN, RETATTR>(env, r).Get());
+    }
+  }
+  return result;
+}
+
+// FunctionWrapperBatch is a three-stage function (refer to the comments in nofunction.h)
+// Second stage, two variants (except and noexcept)
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...)>
+NOBIND_INLINE Napi::Value FunctionWrapperBatch(const Napi::CallbackInfo &info,
+                                               std::integral_constant<RETURN (*)(ARGS...), FUNC>) {
+  try {
+    return BatchCall<RETATTR, ARGATTR, RETURN, ARGS...>(
+        info, [](auto &&...args) -> RETURN { return FUNC(std::forward<decltype(args)>(args)...); },
+        std::index_sequence_for<ARGS...>{});
+  } catch (const std::exception &e) {
+    throw Napi::Error::New(info.Env(), e.what());
+  }
+}
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...) noexcept>
+NOBIND_INLINE Napi::Value FunctionWrapperBatch(const Napi::CallbackInfo &info,
+                                               std::integral_constant<RETURN (*)(ARGS...) noexcept, FUNC>) {
+  return BatchCall<RETATTR, ARGATTR, RETURN, ARGS...>(
+      info, [](auto &&...args) -> RETURN { return FUNC(std::forward<decltype(args)>(args)...); },
+      std::index_sequence_for<ARGS...>{});
+}
+
+// First stage
+template <const ReturnAttribute &RETATTR = ReturnDefault, auto *FUNC,
+          const ArgumentAttribute &ARGATTR = ArgumentDefault>
+Napi::Value FunctionWrapperBatch(const Napi::CallbackInfo &info) {
+  return FunctionWrapperBatch<RETATTR, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
+}
+
+// Parallel batch calls
+//
+// A function bound with ReturnParallel is a batch call running in the background.
+// The elements are captured on the main thread, then they are split in chunks
+// and each chunk is an AsyncWorker in the libuv thread pool. The Promise is
+// settled by the last chunk to complete.
+
+// The state shared by all the chunks of a parallel batch call
+template <const ReturnAttribute &RETATTR, auto *FUNC, typename RETURN, typename ELEMENT> class ParallelBatch {
+  using R = std::remove_cv_t<RETURN>;
+  static constexpr bool typed = IsTypedArrayElement_v<R>;
+
+  Napi::Env env_;
+  Napi::Promise::Deferred deferred_;
+  // Numbers are written directly in the resulting TypedArray,
+  // the other results are converted to JS on the main thread
+  Napi::Reference<Napi::Value> result_;
+  R *output_;
+  std::vector<std::unique_ptr<ToJS_t<RETURN, RETATTR>>> results_;
+  size_t pending_;
+  std::string error_;
+  bool failed_;
+
+  template <size_t... I> NOBIND_INLINE void Call(size_t i, std::index_sequence<I...>) {
+    ELEMENT &args = inputs[i];
+#ifndef NOBIND_NO_ASYNC_LOCKING
+    [[maybe_unused]] std::tuple<FromJSTypemapLockGuard<std::tuple_element_t<I, ELEMENT>>...> lock_guards{
+        std::get<I>(args)...};
+#endif
+    if constexpr (std::is_void_v<R>) {
+      FUNC(std::get<I>(args).Get()...);
+    } else if constexpr (typed) {
+      output_[i] = FUNC(std::get<I>(args).Get()...);
+    } else {
+      RETURN r = FUNC(std::get<I>(args).Get()...);
+      results_[i] = std::make_unique<ToJS_t<RETURN, RETATTR>>(env_, r);
+    }
+  }
+
+public:
+  std::vector<ELEMENT> inputs;
+
+  ParallelBatch(Napi::Env env, Napi::Promise::Deferred deferred, size_t length)
+      : env_(env), deferred_(deferred), output_(nullptr), pending_(0), failed_(false) {
+    inputs.reserve(length);
+    if constexpr (typed) {
+      result_ = Napi::Persistent(BatchTypedArray<R>(env, length, output_));
+    } else if constexpr (!std::is_void_v<R>) {
+      results_.resize(length);
+    }
+  }
+
+  // Called on a worker thread
+  void Run(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++)
+      Call(i, std::make_index_sequence<std::tuple_size_v<ELEMENT>>{});
+  }
+
+  // Called on the main thread
+  void Start(size_t chunks) { pending_ = chunks; }
+  void Fail(const std::string &error) {
+    if (!failed_)
+      error_ = error;
+    failed_ = true;
+  }
+  void Done() {
+    if (pending_ > 0 && --pending_ > 0)
+      return;
+    if (failed_) {
+      deferred_.Reject(Napi::Error::New(env_, error_).Value());
+      return;
+    }
+    try {
+      if constexpr (std::is_void_v<R>) {
+        deferred_.Resolve(env_.Undefined());
+      } else if constexpr (typed) {
+        deferred_.Resolve(result_.Value());
+      } else {
+        Napi::Array array = Napi::Array::New(env_, results_.size());
+        for (size_t i = 0; i < results_.size(); i++)
+          array.Set(static_cast<uint32_t>(i), results_[i]->Get());
+        deferred_.Resolve(array);
+      }
+    } catch (const std::exception &e) {
+      deferred_.Reject(Napi::Error::New(env_, e.what()).Value());
+    }
+  }
+};
+
+// A chunk of a parallel batch call
+template <typename STATE> class ParallelBatchTasklet : public Napi::AsyncWorker {
+  std::shared_ptr<STATE> state_;
+  size_t begin_, end_;
+
+public:
+  ParallelBatchTasklet(Napi::Env env, std::shared_ptr<STATE> state, size_t begin, size_t end)
+      : AsyncWorker(env, "nobind_ParallelBatch"), state_(state), begin_(begin), end_(end) {}
+
+  virtual void Execute() override {
+    try {
+      state_->Run(begin_, end_);
+    } catch (const std::exception &e) {
+      SetError(e.what());
+    }
+  }
+
+  virtual void OnOK() override { state_->Done(); }
+
+  virtual void OnError(const Napi::Error &e) override {
+    state_->Fail(e.Message());
+    state_->Done();
+  }
+};
+
+// FunctionWrapperParallel is a three-stage function (refer to the comments in nofunction.h)
+// Third stage
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, auto *FUNC, typename RETURN,
+          typename... ARGS, size_t... I>
+NOBIND_INLINE Napi::Value FunctionWrapperParallel(const Napi::CallbackInfo &info, std::index_sequence<I...>) {
+  static_assert(!RETATTR.isNested(), "Parallel batch calls cannot return nested objects");
+  static_assert(!RETATTR.isLimited(), "Parallel batch calls cannot be limited");
+  Napi::Env env = info.Env();
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+
+  try {
+    size_t length;
+    auto columns = BatchColumnsAll<ARGATTR, ARGS...>(info, length, std::index_sequence<I...>{});
+    using ELEMENT = std::tuple<decltype(std::get<I>(columns).template Element<true>(0))...>;
+    using STATE = ParallelBatch<RETATTR, FUNC, RETURN, ELEMENT>;
+
+    auto state = std::make_shared<STATE>(env, deferred, length);
+    for (size_t i = 0; i < length; i++) {
+      // Braced initialization guarantees the evaluation order
+      state->inputs.push_back(ELEMENT{std::get<I>(columns).template Element<true>(i)...});
+    }
+
+    size_t chunks = std::min<size_t>(length, std::max(1u, std::thread::hardware_concurrency()));
+    state->Start(chunks);
+    if (chunks == 0)
+      state->Done();
+    for (size_t c = 0; c < chunks; c++) {
+      auto tasklet = new ParallelBatchTasklet<STATE>(env, state, length * c / chunks, length * (c + 1) / chunks);
+      tasklet->Queue();
+    }
+  } catch (const std::exception &e) {
+    deferred.Reject(Napi::Error::New(env, e.what()).Value());
+  }
+  return deferred.Promise();
+}
+
+// Second stage, two variants (except and noexcept)
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...)>
+NOBIND_INLINE Napi::Value FunctionWrapperParallel(const Napi::CallbackInfo &info,
+                                                  std::integral_constant<RETURN (*)(ARGS...), FUNC>) {
+  return FunctionWrapperParallel<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+}
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...) noexcept>
+NOBIND_INLINE Napi::Value FunctionWrapperParallel(const Napi::CallbackInfo &info,
+                                                  std::integral_constant<RETURN (*)(ARGS...) noexcept, FUNC>) {
+  return FunctionWrapperParallel<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+}
+
+// First stage
+template <const ReturnAttribute &RETATTR = ReturnDefault, auto *FUNC,
+          const ArgumentAttribute &ARGATTR = ArgumentDefault>
+Napi::Value FunctionWrapperParallel(const Napi::CallbackInfo &info) {
+  return FunctionWrapperParallel<RETATTR, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
+}
+
+} // namespace Nobind
@@ -15,6 +15,7 @@
 
 #include <noattributes.h>
 
+#include <nobatch.h>
 #include <nofunction.h>
 
 #include <nobuffer.h>
@@ -24,11 +25,20 @@
 #include <nosmartptr.h>
 #include <nostl.h>
 #include <nostringmaps.h>
+#include <nostruct.h>
+#include <notypedarray.h>
+
+#include <nocoro.h>
+#include <nofuture.h>
 
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
 #include <notypescript.h>
 #endif
 
+#ifdef NOBIND_JS_SHIM
+#include <noshim.h>
+#endif
+
 namespace Nobind {
 
 template <char const MODULE[]> class Module {
@@ -38,6 +48,18 @@ template <char const MODULE[]> class Module {
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
   std::string typescript_types_;
 #endif
+#ifdef NOBIND_JS_SHIM
+  std::string js_shim_;
+#endif
+
+  // The non-enumerable statistics functions, they are included in the TypeScript types
+  void StatsFunction(const char *name, Napi::Function::Callback getter, void *data, [[maybe_unused]] const char *type) {
+    exports_.DefineProperty(
+        Napi::PropertyDescriptor::Value(name, Napi::Function::New(env_, getter, name, data), napi_default));
+#ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
+    typescript_types_ += "export function "s + name + "(): " + type + ";\n";
+#endif
+  }
 
 public:
   Module(Napi::Env env, Napi::Object exports)
@@ -45,6 +67,10 @@ public:
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
         ,
         typescript_types_{""}
+#endif
+#ifdef NOBIND_JS_SHIM
+        ,
+        js_shim_{""}
 #endif
   {
   }
@@ -55,6 +81,11 @@ public:
 #ifndef NOBIND_NO_OBJECT_STORE
     instance->_Nobind_object_store = new ObjectStore<void *>(class_idx_);
 #endif
+    instance->_Nobind_interned_strings = new InternedStrings;
+    instance->_Nobind_property_keys = new PropertyKeys;
+    PropertyKey<key_done>(env_);
+    PropertyKey<key_value>(env_);
+    PropertyKey<key_parent>(env_);
     auto r = napi_add_async_cleanup_hook(
         env_,
         [](napi_async_cleanup_hook_handle hook, void *arg) {
@@ -65,6 +96,14 @@ public:
           delete instance->_Nobind_object_store;
           instance->_Nobind_object_store = nullptr;
 #endif
+          delete instance->_Nobind_interned_strings;
+          instance->_Nobind_interned_strings = nullptr;
+          delete instance->_Nobind_property_keys;
+          instance->_Nobind_property_keys = nullptr;
+          instance->_Nobind_async_limiters.Drain();
+          // Stop the waiter thread before closing the main thread queue
+          delete instance->_Nobind_future_waiter;
+          instance->_Nobind_future_waiter = nullptr;
           uv_close(reinterpret_cast<uv_handle_t *>(instance->_Nobind_js_thread_async_handle), [](uv_handle_t *async) {
             auto instance = static_cast<BaseEnvInstanceData *>(async->data);
             NOBIND_VERBOSE(INIT, "Environment cleanup hook bottom half for %p\n", instance);
@@ -80,36 +119,93 @@ public:
     if (r != napi_ok) {
       throw Napi::Error::New(env_, "Failed to register Object Store cleanup hook");
     }
+    if (!instance->_Nobind_adaptive_bindings.empty()) {
+      StatsFunction(NOBIND_ADAPTIVE_PROP, AdaptiveStatsGetter, &instance->_Nobind_adaptive_bindings,
+                    "Record<string, { estimate: number, samples: number, inline: number, offloaded: number }>");
+    }
+    if (!instance->_Nobind_async_limiters.bindings.empty()) {
+      StatsFunction(
+          NOBIND_LIMITS_PROP, AsyncLimitsGetter, &instance->_Nobind_async_limiters,
+          "Record<string, { max: number, inflight: number, queued: number, rejected: number, dropped: number }>");
+    }
+    if (instance->_Nobind_async_dispatcher.Used()) {
+      StatsFunction(NOBIND_PRIORITY_PROP, AsyncLanesGetter, &instance->_Nobind_async_dispatcher,
+                    "{ slots: number, running: number } & Record<'high' | 'normal' | 'background', "
+                    "{ queued: number, dispatched: number, promoted: number, cancelled: number }>");
+    }
+    if (!instance->_Nobind_memoized_bindings.empty()) {
+      StatsFunction(
+          NOBIND_MEMOIZE_PROP, MemoStatsGetter, &instance->_Nobind_memoized_bindings,
+          "Record<string, { hits: number, misses: number, evictions: number, size: number, clear: () => void }>");
+    }
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
     exports_.DefineProperty(Napi::PropertyDescriptor::Value(NOBIND_TYPESCRIPT_PROP,
                                                             Napi::String::New(env_, typescript_types_), napi_default));
+#endif
+#ifdef NOBIND_JS_SHIM
+    exports_.DefineProperty(
+        Napi::PropertyDescriptor::Value(NOBIND_SHIM_PROP, Napi::String::New(env_, ShimModule(js_shim_)), napi_default));
 #endif
   }
 
   // Global function
-  template <auto *OBJECT, const ReturnAttribute &RET = ReturnDefault>
+  template <auto *OBJECT, const ReturnAttribute &RET = ReturnDefault,
+            const ArgumentAttribute &ARGATTR = ArgumentDefault>
   std::enable_if_t<std::is_function_v<std::remove_pointer_t<decltype(OBJECT)>>, Module<MODULE>> &def(const char *name) {
     Napi::Function::Callback wrapper;
-    if constexpr (RET.isAsync()) {
-      wrapper = FunctionWrapperAsync<RET, OBJECT>;
+    if constexpr (RET.isParallel()) {
+      wrapper = FunctionWrapperParallel<RET, OBJECT, ARGATTR>;
+    } else if constexpr (RET.isAsync()) {
+      wrapper = FunctionWrapperAsync<RET, OBJECT, ARGATTR>;
+    } else if constexpr (RET.isBatch()) {
+      wrapper = FunctionWrapperBatch<RET, OBJECT, ARGATTR>;
     } else {
-      wrapper = FunctionWrapper<RET, OBJECT>;
+      wrapper = FunctionWrapper<RET, OBJECT, ARGATTR>;
     }
     Napi::Function js = Napi::Function::New(env_, wrapper);
     exports_.Set(name, js);
+    if constexpr (RET.isAdaptive()) {
+      env_.GetInstanceData<BaseEnvInstanceData>()->_Nobind_adaptive_bindings.emplace_back(name, &Adaptive<OBJECT>());
+    }
+    if constexpr (RET.isLimited()) {
+      env_.GetInstanceData<BaseEnvInstanceData>()->_Nobind_async_limiters.template Add<OBJECT, RET>(env_, name, js);
+    }
+    if constexpr (RET.isPrioritized()) {
+      GetAsyncDispatcher(env_).Use();
+    }
+    if constexpr (RET.isMemoized()) {
+      env_.GetInstanceData<BaseEnvInstanceData>()->_Nobind_memoized_bindings.emplace_back(name,
+                                                                                          &MemoizedFunction<OBJECT>());
+    }
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
-    typescript_types_ += FunctionSignature<RET, OBJECT>(name, "export function ");
+    typescript_types_ += FunctionSignature<RET, OBJECT, ARGATTR>(name, "export function ");
+#endif
+#ifdef NOBIND_JS_SHIM
+    // The unchecked entry point called by the JS shim
+    // (batch functions check their arrays only once and are not shimmed,
+    // cancellable functions have a variable number of arguments)
+    if constexpr (!RET.isBatch() && !RET.isParallel() && !RET.isCancellable()) {
+      Napi::Function::Callback unchecked;
+      if constexpr (RET.isAsync()) {
+        unchecked = FunctionWrapperAsync<RET, OBJECT, ArgWithUnchecked<ARGATTR>>;
+      } else {
+        unchecked = FunctionWrapper<RET, OBJECT, ArgWithUnchecked<ARGATTR>>;
+      }
+      exports_.DefineProperty(Napi::PropertyDescriptor::Value(NOBIND_SHIM_UNCHECKED_PREFIX + std::string{name},
+                                                              Napi::Function::New(env_, unchecked), napi_default));
+      js_shim_ += FunctionShim<RET, OBJECT, ARGATTR>(name);
+    }
 #endif
     return *this;
   }
 
   // Global function / sync+async shortcut
-  template <auto OBJECT, const ReturnAttribute &RET = ReturnDefault>
+  template <auto OBJECT, const ReturnAttribute &RET = ReturnDefault, const ArgumentAttribute &ARGATTR = ArgumentDefault>
   std::enable_if_t<std::is_function_v<std::remove_pointer_t<decltype(OBJECT)>>, Module<MODULE>> &
   def(const char *name_sync, const char *name_async) {
     static_assert(!RET.isAsync(), "Do not specify async with the duplex definition");
-    def<OBJECT, RET>(name_sync);
-    def<OBJECT, RetWithAsync<RET>>(name_async);
+    def<OBJECT, RET, ARGATTR>(name_sync);
+    def<OBJECT, RetWithAsync<RET>, ARGATTR>(name_async);
     return *this;
   }
 
@@ -0,0 +1,167 @@
+#pragma once
+#include <nonapi.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <noattributes.h>
+#include <notypes.h>
+
+namespace Nobind {
+
+// Cancellation of async calls
+//
+// A ReturnCancellable binding accepts an optional trailing AbortSignal. When
+// the signal is aborted, the Promise is rejected with its reason. If the tasklet
+// has not started, it is removed from the thread pool queue and it is destroyed,
+// otherwise its result is discarded. C++ functions can poll for the cancellation
+// with a Nobind::CancellationToken argument that does not consume a JS argument.
+
+struct CancellationState {
+  std::atomic<bool> cancelled{false};
+  // The tasklet is waiting in a priority lane and it is not in the thread pool queue,
+  // only accessed on the main thread
+  bool held = false;
+};
+
+class CancellationToken {
+  std::shared_ptr<CancellationState> state_;
+
+public:
+  CancellationToken() : state_(std::make_shared<CancellationState>()) {}
+  explicit CancellationToken(std::shared_ptr<CancellationState> state) : state_(std::move(state)) {}
+
+  // Can be called from any thread
+  bool cancelled() const { return state_->cancelled.load(std::memory_order_relaxed); }
+  void throwIfCancelled() const {
+    if (cancelled())
+      throw std::runtime_error("Operation cancelled");
+  }
+};
+
+namespace Typemap {
+
+// Typemap that generates the CancellationToken of the call w/o consuming input
+class FromJSCancellationToken {
+  CancellationToken val_;
+
+public:
+  NOBIND_INLINE explicit FromJSCancellationToken(const Napi::Value &) : val_() {}
+  NOBIND_INLINE const CancellationToken &Get() { return val_; }
+  void Bind(const std::shared_ptr<CancellationState> &state) { val_ = CancellationToken{state}; }
+  static const std::string TSType() { return ""; };
+
+  static const size_t Inputs = 0;
+};
+
+template <> class FromJS<CancellationToken> : public FromJSCancellationToken {
+public:
+  using FromJSCancellationToken::FromJSCancellationToken;
+};
+template <> class FromJS<const CancellationToken &> : public FromJSCancellationToken {
+public:
+  using FromJSCancellationToken::FromJSCancellationToken;
+};
+
+} // namespace Typemap
+
+// Connect the CancellationToken arguments to the state of the call
+template <typename TUPLE, size_t... I>
+void BindCancellation(TUPLE &args, const std::shared_ptr<CancellationState> &state, std::index_sequence<I...>) {
+  (
+      [&]() {
+        if constexpr (std::is_base_of_v<Typemap::FromJSCancellationToken, std::tuple_element_t<I, TUPLE>>)
+          std::get<I>(args).Bind(state);
+      }(),
+      ...);
+}
+
+// Is there an AbortSignal after the idx JS arguments of a cancellable call
+template <const ReturnAttribute &RETATTR>
+NOBIND_INLINE bool HasAbortSignal(const Napi::CallbackInfo &info, size_t idx) {
+  if constexpr (RETATTR.isCancellable()) {
+    return info.Length() == idx + 1;
+  } else {
+    return false;
+  }
+}
+
+// The tasklet side, subscribes to the AbortSignal
+class AsyncCancellation {
+  std::shared_ptr<CancellationState> state_;
+  Napi::Reference<Napi::Object> signal_;
+  Napi::FunctionReference listener_;
+  // The Promise has been rejected, only accessed on the main thread
+  bool aborted_;
+
+  static Napi::Value Reason(Napi::Object signal) {
+    Napi::Value reason = signal.Get("reason");
+    if (reason.IsUndefined())
+      return Napi::Error::New(signal.Env(), "The operation was aborted").Value();
+    return reason;
+  }
+
+public:
+  AsyncCancellation() : state_(), aborted_(false) {}
+  AsyncCancellation(const AsyncCancellation &) = delete;
+
+  ~AsyncCancellation() {
+    if (listener_.IsEmpty())
+      return;
+    try {
+      Napi::Object signal = signal_.Value();
+      signal.Get("removeEventListener")
+          .As<Napi::Function>()
+          .Call(signal, {Napi::String::New(signal.Env(), "abort"), listener_.Value()});
+    } catch (const std::exception &) {
+      // The environment is shutting down
+    }
+  }
+
+  // Subscribe the tasklet, returns false if the signal has already been aborted
+  // and the Promise has been rejected
+  template <typename TASKLET> bool Attach(Napi::Value val, TASKLET *tasklet, Napi::Promise::Deferred deferred) {
+    state_ = std::make_shared<CancellationState>();
+    if (val.IsUndefined())
+      return true;
+    if (!val.IsObject() || !val.ToObject().Get("addEventListener").IsFunction())
+      throw Napi::TypeError::New(val.Env(), "Expected an AbortSignal");
+    Napi::Object signal = val.ToObject();
+    if (signal.Get("aborted").ToBoolean().Value()) {
+      state_->cancelled = true;
+      deferred.Reject(Reason(signal));
+      return false;
+    }
+    Napi::Function listener =
+        Napi::Function::New(val.Env(), [this, tasklet, deferred](const Napi::CallbackInfo &info) -> Napi::Value {
+          aborted_ = true;
+          state_->cancelled = true;
+          deferred.Reject(Reason(signal_.Value()));
+          // A held tasklet is destroyed by the dispatcher
+          if (state_->held)
+            return info.Env().Undefined();
+          try {
+            // Succeeds only if the tasklet has not started, it will be destroyed
+            tasklet->Cancel();
+          } catch (const std::exception &) {
+          }
+          return info.Env().Undefined();
+        });
+    signal.Get("addEventListener")
+        .As<Napi::Function>()
+        .Call(signal, {Napi::String::New(val.Env(), "abort"), listener});
+    signal_ = Napi::Persistent(signal);
+    listener_ = Napi::Persistent(listener);
+    return true;
+  }
+
+  bool Aborted() const { return aborted_; }
+  const std::shared_ptr<CancellationState> &State() const { return state_; }
+};
+
+} // namespace Nobind
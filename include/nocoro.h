@@ -0,0 +1,297 @@
+#pragma once
+#include <nonapi.h>
+
+// C++20 builds only
+#ifdef __cpp_impl_coroutine
+#include <coroutine>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <noobject.h>
+#include <notypes.h>
+
+#include <uv.h>
+
+namespace Nobind {
+
+// C++20 coroutines
+//
+// A bound function returning a Nobind::Task<T> returns a Promise. The coroutine
+// starts on the main thread when the function is called, co_await ResumeOnWorker()
+// moves it to the libuv thread pool and co_await ResumeOnMain() brings it back to
+// the main thread where JS values can be used. All the hops of a call reuse the
+// same uv_work_t, the coroutine returns to the main thread in the completion
+// callback of the work request. A Task can co_await other Tasks, they share the
+// state of the call. The Promise is settled on the main thread. Other awaitables
+// cannot be used as they would resume the coroutine on a thread unknown to libuv.
+
+// The state of a call of a bound coroutine, from the first resumption to the Promise
+class CoroutineCall {
+  Napi::AsyncContext context_;
+  uv_loop_t *loop_;
+  uv_work_t req_;
+  // The coroutine to resume on the other side of the hop
+  std::coroutine_handle<> resume_;
+  // The coroutine has been queued in the thread pool, only accessed on the main thread
+  bool queued_;
+  bool done_;
+
+  // The call running on this thread of the pool
+  static inline thread_local CoroutineCall *worker_ = nullptr;
+
+  static void Work(uv_work_t *req) {
+    auto call = static_cast<CoroutineCall *>(req->data);
+    worker_ = call;
+    std::exchange(call->resume_, nullptr).resume();
+    worker_ = nullptr;
+  }
+
+  static void AfterWork(uv_work_t *req, int) {
+    auto call = static_cast<CoroutineCall *>(req->data);
+    bool done;
+    {
+      Napi::HandleScope scope(call->env_);
+      Napi::CallbackScope callback(call->env_, call->context_);
+      done = call->Drive();
+    }
+    // The scopes use the async context of the call
+    if (done)
+      delete call;
+  }
+
+protected:
+  Napi::Env env_;
+
+  // Convert the result on the main thread
+  virtual void Settle() = 0;
+
+  // Resume the coroutine on the main thread, returns true when the Promise has been settled
+  bool Drive() {
+    queued_ = false;
+    if (resume_)
+      std::exchange(resume_, nullptr).resume();
+    // The coroutine may be already running on a worker thread
+    if (queued_)
+      return false;
+    if (done_)
+      Settle();
+    return done_;
+  }
+
+  // The first resumption, within the JS call
+  bool Start(std::coroutine_handle<> root) {
+    resume_ = root;
+    return Drive();
+  }
+
+public:
+  explicit CoroutineCall(Napi::Env env)
+      : context_(env, "nobind_Coroutine"), loop_(nullptr), req_(), resume_(), queued_(false), done_(false),
+        env_(env) {
+    if (napi_get_uv_event_loop(env, &loop_) != napi_ok)
+      throw Napi::Error::New(env, "Failed to get the event loop");
+    req_.data = this;
+  }
+  CoroutineCall(const CoroutineCall &) = delete;
+  virtual ~CoroutineCall() {}
+
+  static bool OnWorker() { return worker_ != nullptr; }
+
+  // Called on the main thread
+  void ToWorker(std::coroutine_handle<> h) {
+    resume_ = h;
+    queued_ = true;
+    if (uv_queue_work(loop_, &req_, Work, AfterWork) != 0)
+      std::abort();
+  }
+
+  // Called on a worker thread, the coroutine is resumed by AfterWork
+  void ToMain(std::coroutine_handle<> h) { resume_ = h; }
+
+  // The outermost Task has returned
+  void Done() { done_ = true; }
+};
+
+// The awaitables accepted in a Task
+template <typename T> class Task;
+struct ResumeOnWorker;
+struct ResumeOnMain;
+
+template <typename A> struct IsTaskAwaitable : std::false_type {};
+template <typename T> struct IsTaskAwaitable<Task<T>> : std::true_type {};
+template <> struct IsTaskAwaitable<ResumeOnWorker> : std::true_type {};
+template <> struct IsTaskAwaitable<ResumeOnMain> : std::true_type {};
+
+class TaskPromiseBase {
+public:
+  CoroutineCall *call_ = nullptr;
+  // The awaiting Task
+  std::coroutine_handle<> continuation_;
+  std::exception_ptr exception_;
+
+  // A Task starts when it is awaited or when it is returned to JS
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename P> std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+      TaskPromiseBase &promise = h.promise();
+      if (promise.continuation_)
+        return promise.continuation_;
+      promise.call_->Done();
+      return std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+  };
+  FinalAwaiter final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+  template <typename A> A &&await_transform(A &&awaitable) noexcept {
+    static_assert(IsTaskAwaitable<std::remove_cv_t<std::remove_reference_t<A>>>::value,
+                  "A Nobind::Task can only co_await a Nobind::Task, ResumeOnWorker or ResumeOnMain");
+    return std::forward<A>(awaitable);
+  }
+};
+
+template <typename T> class TaskPromise : public TaskPromiseBase {
+  std::optional<T> value_;
+
+public:
+  Task<T> get_return_object();
+  template <typename U> void return_value(U &&value) { value_.emplace(std::forward<U>(value)); }
+  T Result() {
+    if (exception_)
+      std::rethrow_exception(exception_);
+    return std::move(*value_);
+  }
+};
+
+template <> class TaskPromise<void> : public TaskPromiseBase {
+public:
+  Task<void> get_return_object();
+  void return_void() {}
+  void Result() {
+    if (exception_)
+      std::rethrow_exception(exception_);
+  }
+};
+
+// The coroutine type, owns the coroutine frame
+template <typename T = void> class [[nodiscard]] Task {
+public:
+  using promise_type = TaskPromise<T>;
+
+private:
+  std::coroutine_handle<promise_type> handle_;
+
+  struct Awaiter {
+    std::coroutine_handle<promise_type> handle_;
+
+    bool await_ready() const noexcept { return false; }
+    // Symmetric transfer to the awaited Task
+    template <typename P> std::coroutine_handle<> await_suspend(std::coroutine_handle<P> caller) noexcept {
+      handle_.promise().call_ = caller.promise().call_;
+      handle_.promise().continuation_ = caller;
+      return handle_;
+    }
+    T await_resume() { return handle_.promise().Result(); }
+  };
+
+public:
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+  Task(const Task &) = delete;
+  Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+  ~Task() {
+    if (handle_)
+      handle_.destroy();
+  }
+
+  Awaiter operator co_await() && noexcept { return Awaiter{handle_}; }
+
+  // Used by the ToJS typemap
+  std::coroutine_handle<promise_type> Handle() const { return handle_; }
+};
+
+template <typename T> Task<T> TaskPromise<T>::get_return_object() {
+  return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+inline Task<void> TaskPromise<void>::get_return_object() {
+  return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+template <typename T> struct IsTask<Task<T>> : std::true_type {};
+
+// co_await Nobind::ResumeOnWorker() continues the coroutine in the thread pool
+struct ResumeOnWorker {
+  bool await_ready() const noexcept { return CoroutineCall::OnWorker(); }
+  template <typename P> void await_suspend(std::coroutine_handle<P> h) { h.promise().call_->ToWorker(h); }
+  void await_resume() const noexcept {}
+};
+
+// co_await Nobind::ResumeOnMain() continues the coroutine on the main thread
+struct ResumeOnMain {
+  bool await_ready() const noexcept { return !CoroutineCall::OnWorker(); }
+  template <typename P> void await_suspend(std::coroutine_handle<P> h) { h.promise().call_->ToMain(h); }
+  void await_resume() const noexcept {}
+};
+
+// The call of a bound coroutine returning T
+template <typename T, const ReturnAttribute &RETATTR> class CoroutineCallImpl : public CoroutineCall {
+  Task<T> task_;
+  Napi::Promise::Deferred deferred_;
+
+  virtual void Settle() override {
+    try {
+      if constexpr (std::is_void_v<T>) {
+        task_.Handle().promise().Result();
+        deferred_.Resolve(env_.Undefined());
+      } else {
+        T result = task_.Handle().promise().Result();
+        deferred_.Resolve(ToJS_t<T, RETATTR>(env_, result).Get());
+      }
+    } catch (const std::exception &e) {
+      deferred_.Reject(Napi::Error::New(env_, e.what()).Value());
+    } catch (...) {
+      // Settle() runs in a libuv callback, nothing can be thrown out of it
+      deferred_.Reject(Napi::Error::New(env_, "Unknown exception").Value());
+    }
+  }
+
+public:
+  CoroutineCallImpl(Napi::Env env, Task<T> &&task)
+      : CoroutineCall(env), task_(std::move(task)), deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  // The call deletes itself once the Promise has been settled
+  static Napi::Value New(Napi::Env env, Task<T> &&task) {
+    auto call = new CoroutineCallImpl(env, std::move(task));
+    Napi::Promise promise = call->deferred_.Promise();
+    call->task_.Handle().promise().call_ = call;
+    if (call->Start(call->task_.Handle()))
+      delete call;
+    return promise;
+  }
+};
+
+namespace Typemap {
+
+// C++ Nobind::Task<T> -> JS Promise
+template <typename T, const ReturnAttribute &RETATTR> class ToJS<Task<T>, RETATTR> {
+  Napi::Env env_;
+  Task<T> val_;
+
+public:
+  NOBIND_INLINE explicit ToJS(Napi::Env env, Task<T> &val) : env_(env), val_(std::move(val)) {}
+  NOBIND_INLINE Napi::Value Get() { return CoroutineCallImpl<T, RETATTR>::New(env_, std::move(val_)); }
+
+  static std::string TSType() { return "Promise<"s + ToTSType<T, RETATTR>() + ">"s; }
+};
+
+} // namespace Typemap
+
+} // namespace Nobind
+
+#endif
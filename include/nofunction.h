@@ -1,37 +1,60 @@
 #pragma once
+#include <noadaptive.h>
 #include <noattributes.h>
+#include <nocancel.h>
+#include <nolimit.h>
+#include <nomemo.h>
 #include <nonapi.h>
+#include <nopriority.h>
+
+#include <optional>
+#include <string>
 
 namespace Nobind {
 
 // This is a 3-stage version of a trick using std::integral_constant which is proposed here:
 // https://stackoverflow.com/questions/77404330/function-template-with-variable-argument-function-as-template-argument
 // (this is the 3rd stage)
-template <const ReturnAttribute &RETATTR, auto *FUNC, typename RETURN, typename... ARGS, std::size_t... I>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, auto *FUNC, typename RETURN,
+          typename... ARGS, std::size_t... I>
 NOBIND_INLINE Napi::Value FunctionWrapper(const Napi::CallbackInfo &info, std::index_sequence<I...>) {
+  static_assert(CoroutineArgsByValue_v<RETURN, ARGS...>,
+                "Coroutines returning a Nobind::Task must take their arguments by value");
   Napi::Env env = info.Env();
 
   try {
     // Call the FromJS constructors
     //
     size_t idx = 0;
-    std::tuple<FromJS_t<ARGS>...> args{FromJSArgs<ARGS>(info, idx)...};
+    [[maybe_unused]] auto args = FromJSArgsAll<ARGATTR, ARGS...>(info, idx, std::index_sequence_for<ARGS...>{});
     CheckArgLength(env, idx, info.Length());
 #ifndef NOBIND_NO_ASYNC_LOCKING
-    [[maybe_unused]] std::tuple<FromJSLockGuard<ARGS>...> lock_guards{std::get<I>(args)...};
+    [[maybe_unused]] FromJSArgsLockGuards_t<ARGATTR, ARGS...> lock_guards{std::get<I>(args)...};
 #endif
     if constexpr (std::is_void_v<RETURN>) {
       // Convert and call
-      FUNC(std::get<I>(args).Get()...);
-      return env.Undefined();
+      FUNC(FromJSArgGet<I, ARGATTR, ARGS...>(args)...);
+      return ToJSResults<ARGATTR, false, ARGS...>(env, env.Undefined(), args, std::index_sequence_for<ARGS...>{});
       // FromJS objects are destroyed
+    } else if constexpr (RETATTR.isMemoized()) {
+      static_assert(FromJSArgsLayout<ARGATTR, ARGS...>::Outputs() == 0,
+                    "Memoized functions cannot have output arguments");
+      auto &cache = Memoized<FUNC, RETURN, ARGS...>();
+      MemoKey_t<ARGS...> key{FromJSArgGet<I, ARGATTR, ARGS...>(args)...};
+      auto result = cache.Find(key);
+      if (!result.has_value()) {
+        // Convert and call
+        result = FUNC(FromJSArgGet<I, ARGATTR, ARGS...>(args)...);
+        cache.Store(std::move(key), *result);
+      }
+      return ToJS_t<RETURN, RETATTR>(env, *result).Get();
     } else {
       // Convert and call
-      RETURN result = FUNC(std::get<I>(args).Get()...);
+      RETURN result = FUNC(FromJSArgGet<I, ARGATTR, ARGS...>(args)...);
       // Call the ToJS constructor
       auto output = ToJS_t<RETURN, RETATTR>(env, result);
       // Convert
-      return output.Get();
+      return ToJSResults<ARGATTR, true, ARGS...>(env, output.Get(), args, std::index_sequence_for<ARGS...>{});
       // FromJS/ToJS objects are destroyed
     }
   } catch (const std::exception &e) {
@@ -39,79 +62,173 @@ NOBIND_INLINE Napi::Value FunctionWrapper(const Napi::CallbackInfo &info, std::i
   }
 }
 
-template <const ReturnAttribute &RETATTR, auto *FUNC, typename RETURN, typename... ARGS>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, auto *FUNC, typename RETURN,
+          typename... ARGS>
 class FunctionWrapperTasklet : public Napi::AsyncWorker {
   Napi::Env env_;
   Napi::Promise::Deferred deferred_;
   std::unique_ptr<ToJS_t<RETURN, RETATTR>> output;
-  std::tuple<FromJS_t<ARGS>...> args_;
+  FromJSArgs_t<ARGATTR, ARGS...> args_;
+  std::optional<std::string> error_;
+  AsyncLimiterSlot slot_;
+  AsyncCancellation cancellation_;
+  AsyncDispatcherSlot priority_;
+  typename MemoKeyHolder<RETATTR.isMemoized(), ARGS...>::type memo_key_;
 
 public:
-  FunctionWrapperTasklet(Napi::Env env, Napi::Promise::Deferred deferred, std::tuple<FromJS_t<ARGS>...> &&args)
+  FunctionWrapperTasklet(Napi::Env env, Napi::Promise::Deferred deferred, FromJSArgs_t<ARGATTR, ARGS...> &&args)
       : AsyncWorker(env, "nobind_AsyncWorker"), env_(env), deferred_(deferred), output(), args_(std::move(args)) {}
 
   template <std::size_t... I> void ExecuteImpl(std::index_sequence<I...>) {
     try {
 #ifndef NOBIND_NO_ASYNC_LOCKING
-      [[maybe_unused]] std::tuple<FromJSLockGuard<ARGS>...> lock_guards{std::get<I>(args_)...};
+      [[maybe_unused]] FromJSArgsLockGuards_t<ARGATTR, ARGS...> lock_guards{std::get<I>(args_)...};
 #endif
+      [[maybe_unused]] AdaptiveTimer<RETATTR, FUNC> timer;
 
       if constexpr (std::is_void_v<RETURN>) {
         // Convert and call
-        FUNC(std::get<I>(args_).Get()...);
+        FUNC(FromJSArgGet<I, ARGATTR, ARGS...>(args_)...);
       } else {
+        if constexpr (RETATTR.isMemoized()) {
+          // The calls with pending conversions are looked up here instead of on the main thread
+          if (!memo_key_.has_value()) {
+            memo_key_.emplace(FromJSArgGet<I, ARGATTR, ARGS...>(args_)...);
+            auto cached = Memoized<FUNC, RETURN, ARGS...>().Find(*memo_key_);
+            if (cached.has_value()) {
+              output = std::make_unique<ToJS_t<RETURN, RETATTR>>(env_, *cached);
+              return;
+            }
+          }
+        }
         // Convert and call
-        RETURN result = FUNC(std::get<I>(args_).Get()...);
+        RETURN result = FUNC(FromJSArgGet<I, ARGATTR, ARGS...>(args_)...);
+        if constexpr (RETATTR.isMemoized()) {
+          Memoized<FUNC, RETURN, ARGS...>().Store(std::move(*memo_key_), result);
+        }
         // Call the ToJS constructor
         output = std::make_unique<ToJS_t<RETURN, RETATTR>>(env_, result);
       }
     } catch (const std::exception &e) {
-      SetError(e.what());
+      error_ = e.what();
+      SetError(*error_);
     }
   }
 
   virtual void Execute() override { ExecuteImpl(std::index_sequence_for<ARGS...>{}); }
 
+  // ReturnLimit, the slot is released when the tasklet is destroyed
+  void Hold(AsyncLimiterSlot &&slot) { slot_ = std::move(slot); }
+
+  // ReturnCancellable, subscribe to the AbortSignal, false if it has already been aborted
+  bool Cancellable(const Napi::Value &signal) {
+    if (!cancellation_.Attach(signal, this, deferred_))
+      return false;
+    BindCancellation(args_, cancellation_.State(), std::index_sequence_for<ARGS...>{});
+    return true;
+  }
+
+  // ReturnMemoized, resolve from the cache on the main thread without running the tasklet,
+  // the key is kept for storing the result, unless a conversion is pending - then
+  // the worker thread builds the key
+  template <std::size_t... I> bool ResolveMemoized(std::index_sequence<I...>) {
+    static_assert(FromJSArgsLayout<ARGATTR, ARGS...>::Outputs() == 0,
+                  "Memoized functions cannot have output arguments");
+    if (FromJSArgsPending<ARGATTR, ARGS...>(args_, std::index_sequence<I...>{}))
+      return false;
+    memo_key_.emplace(FromJSArgGet<I, ARGATTR, ARGS...>(args_)...);
+    auto result = Memoized<FUNC, RETURN, ARGS...>().Find(*memo_key_);
+    if (!result.has_value())
+      return false;
+    try {
+      deferred_.Resolve(ToJS_t<RETURN, RETATTR>(env_, *result).Get());
+    } catch (const std::exception &e) {
+      deferred_.Reject(Napi::Error::New(env_, e.what()).Value());
+    }
+    return true;
+  }
+
+  // ReturnPriority, the dispatcher queues the tasklet when it has a free slot
+  void Prioritize() { GetAsyncDispatcher(env_).Submit(this, priority_, cancellation_.State(), RETATTR.Lane()); }
+
+  // ReturnAdaptive, run on the main thread without being queued
+  void RunInline() {
+    Execute();
+    if (!error_.has_value())
+      OnOK();
+    else
+      OnError(Napi::Error::New(env_, *error_));
+  }
+
   virtual void OnOK() override {
+    // The Promise has already been rejected
+    if (cancellation_.Aborted())
+      return;
     if constexpr (std::is_void_v<RETURN>) {
-      deferred_.Resolve(env_.Undefined());
+      deferred_.Resolve(
+          ToJSResults<ARGATTR, false, ARGS...>(env_, env_.Undefined(), args_, std::index_sequence_for<ARGS...>{}));
     } else {
       try {
         auto result = output->Get();
-        deferred_.Resolve(result);
+        deferred_.Resolve(
+            ToJSResults<ARGATTR, true, ARGS...>(env_, result, args_, std::index_sequence_for<ARGS...>{}));
       } catch (const std::exception &e) {
         deferred_.Reject(Napi::String::New(env_, e.what()));
       }
     }
   }
 
-  virtual void OnError(const Napi::Error &e) override { deferred_.Reject(e.Value()); }
+  virtual void OnError(const Napi::Error &e) override {
+    if (!cancellation_.Aborted())
+      deferred_.Reject(e.Value());
+  }
 };
 
 // Second stage, async, w/except (async has 2 stages + tasklet)
-template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(ARGS...)>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...)>
 NOBIND_INLINE Napi::Value FunctionWrapperAsync(const Napi::CallbackInfo &info,
                                                std::integral_constant<RETURN (*)(ARGS...), FUNC>) {
   Napi::Env env = info.Env();
 
+  AsyncLimiterSlot slot;
+  if constexpr (RETATTR.isLimited()) {
+    AsyncLimiter &limiter = GetAsyncLimiter<FUNC, RETATTR>(env);
+    if (!limiter.Acquire())
+      return limiter.Wait(info);
+    slot = AsyncLimiterSlot{&limiter};
+  }
+
   Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
 
   try {
     size_t idx = 0;
-    // Alas, std::forward_as_tuple does not guarantee
-    // the evaluation order of its arguments, only *braced-init-list* lists do
-    // https://en.cppreference.com/w/cpp/language/list_initialization
-    auto tasklet =
-        new FunctionWrapperTasklet<RETATTR, FUNC, RETURN, ARGS...>(env, deferred, {FromJSArgs<ARGS>(info, idx)...});
+    // FromJSArgsAllDeferred guarantees the evaluation order of the FromJS constructors
+    auto tasklet = new FunctionWrapperTasklet<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(
+        env, deferred, FromJSArgsAllDeferred<ARGATTR, ARGS...>(info, idx, std::index_sequence_for<ARGS...>{}));
+    tasklet->Hold(std::move(slot));
 
     try {
-      CheckArgLength(env, idx, info.Length());
+      // The optional AbortSignal of cancellable calls is the last argument
+      CheckArgLength(env, idx, info.Length() - (HasAbortSignal<RETATTR>(info, idx) ? 1 : 0));
+      if constexpr (RETATTR.isCancellable()) {
+        if (!tasklet->Cancellable(info[idx])) {
+          delete tasklet;
+          return deferred.Promise();
+        }
+      }
     } catch (...) {
       delete tasklet;
       std::rethrow_exception(std::current_exception());
     }
 
-    tasklet->Queue();
+    if constexpr (RETATTR.isMemoized()) {
+      if (tasklet->ResolveMemoized(std::index_sequence_for<ARGS...>{})) {
+        delete tasklet;
+        return deferred.Promise();
+      }
+    }
+    AdaptiveQueue<RETATTR, FUNC>(tasklet);
   } catch (const std::exception &e) {
     deferred.Reject(Napi::Error::New(env, e.what()).Value());
   }
@@ -119,29 +236,50 @@ NOBIND_INLINE Napi::Value FunctionWrapperAsync(const Napi::CallbackInfo &info,
 }
 
 // Second stage, async, noexcept (async has 2 stages + tasklet)
-template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(ARGS...) noexcept>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...) noexcept>
 NOBIND_INLINE Napi::Value FunctionWrapperAsync(const Napi::CallbackInfo &info,
                                                std::integral_constant<RETURN (*)(ARGS...) noexcept, FUNC>) {
   Napi::Env env = info.Env();
 
+  AsyncLimiterSlot slot;
+  if constexpr (RETATTR.isLimited()) {
+    AsyncLimiter &limiter = GetAsyncLimiter<FUNC, RETATTR>(env);
+    if (!limiter.Acquire())
+      return limiter.Wait(info);
+    slot = AsyncLimiterSlot{&limiter};
+  }
+
   Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
 
   try {
     size_t idx = 0;
-    // Alas, std::forward_as_tuple does not guarantee
-    // the evaluation order of its arguments, only *braced-init-list* lists do
-    // https://en.cppreference.com/w/cpp/language/list_initialization
-    auto tasklet =
-        new FunctionWrapperTasklet<RETATTR, FUNC, RETURN, ARGS...>(env, deferred, {FromJSArgs<ARGS>(info, idx)...});
+    // FromJSArgsAllDeferred guarantees the evaluation order of the FromJS constructors
+    auto tasklet = new FunctionWrapperTasklet<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(
+        env, deferred, FromJSArgsAllDeferred<ARGATTR, ARGS...>(info, idx, std::index_sequence_for<ARGS...>{}));
+    tasklet->Hold(std::move(slot));
 
     try {
-      CheckArgLength(env, idx, info.Length());
+      // The optional AbortSignal of cancellable calls is the last argument
+      CheckArgLength(env, idx, info.Length() - (HasAbortSignal<RETATTR>(info, idx) ? 1 : 0));
+      if constexpr (RETATTR.isCancellable()) {
+        if (!tasklet->Cancellable(info[idx])) {
+          delete tasklet;
+          return deferred.Promise();
+        }
+      }
     } catch (...) {
       delete tasklet;
       std::rethrow_exception(std::current_exception());
     }
 
-    tasklet->Queue();
+    if constexpr (RETATTR.isMemoized()) {
+      if (tasklet->ResolveMemoized(std::index_sequence_for<ARGS...>{})) {
+        delete tasklet;
+        return deferred.Promise();
+      }
+    }
+    AdaptiveQueue<RETATTR, FUNC>(tasklet);
   } catch (const std::exception &e) {
     deferred.Reject(Napi::Error::New(env, e.what()).Value());
   }
@@ -149,29 +287,33 @@ NOBIND_INLINE Napi::Value FunctionWrapperAsync(const Napi::CallbackInfo &info,
 }
 
 // Second stage, sync, two variants (except and noexcept)
-template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(ARGS...)>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...)>
 NOBIND_INLINE Napi::Value FunctionWrapper(const Napi::CallbackInfo &info,
                                           std::integral_constant<RETURN (*)(ARGS...), FUNC>) {
-  return FunctionWrapper<RETATTR, FUNC, RETURN, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+  return FunctionWrapper<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(info, std::index_sequence_for<ARGS...>{});
 }
-template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(ARGS...) noexcept>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...) noexcept>
 NOBIND_INLINE Napi::Value FunctionWrapper(const Napi::CallbackInfo &info,
                                           std::integral_constant<RETURN (*)(ARGS...) noexcept, FUNC>) {
-  return FunctionWrapper<RETATTR, FUNC, RETURN, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+  return FunctionWrapper<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(info, std::index_sequence_for<ARGS...>{});
 }
 
 // First stage - this is the function that gets instantiated to create a wrapper (by getting a pointer)
 // and that will be called by JavaScript - it has a Node-API compatible signature)
-template <const ReturnAttribute &RETATTR = ReturnDefault, auto *FUNC>
+template <const ReturnAttribute &RETATTR = ReturnDefault, auto *FUNC,
+          const ArgumentAttribute &ARGATTR = ArgumentDefault>
 Napi::Value FunctionWrapper(const Napi::CallbackInfo &info) {
-  return FunctionWrapper<RETATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
+  return FunctionWrapper<RETATTR, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
 }
 
 // First stage - this is the async function that gets instantiated to create a wrapper (by getting a pointer)
 // and that will be called by JavaScript (ie it has a Node-API compatible signature)
-template <const ReturnAttribute &RETATTR = ReturnDefault, auto *FUNC>
+template <const ReturnAttribute &RETATTR = ReturnDefault, auto *FUNC,
+          const ArgumentAttribute &ARGATTR = ArgumentDefault>
 Napi::Value FunctionWrapperAsync(const Napi::CallbackInfo &info) {
-  return FunctionWrapperAsync<RETATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
+  return FunctionWrapperAsync<RETATTR, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
 }
 
 // Global or class static getter wrapper
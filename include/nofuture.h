@@ -0,0 +1,273 @@
+#pragma once
+#include <nonapi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <nohelpers.h>
+#include <noobject.h>
+#include <notypes.h>
+
+// When several futures are pending, the interval in microseconds at which
+// the waiter checks the futures other than the oldest one, it doubles every
+// time nothing is ready up to NOBIND_FUTURE_POLL_MAX
+#ifndef NOBIND_FUTURE_POLL
+#define NOBIND_FUTURE_POLL 1000
+#endif
+#ifndef NOBIND_FUTURE_POLL_MAX
+#define NOBIND_FUTURE_POLL_MAX 64000
+#endif
+
+namespace Nobind {
+
+// C++ futures
+//
+// A returned std::future or std::shared_future is converted to a Promise
+// without blocking a thread of the pool. The futures of an environment are
+// watched by a single waiter thread that retrieves the result of each ready
+// future and settles its Promise through the main thread queue. The waiter
+// sleeps on a condition variable when there are no futures, otherwise it blocks
+// on the oldest pending future and checks the others at an interval that backs
+// off from NOBIND_FUTURE_POLL to NOBIND_FUTURE_POLL_MAX microseconds.
+// A deferred future runs on the waiter thread. The futures that are still
+// pending when the environment is destroyed are rejected and freed.
+
+class PendingFuture {
+public:
+  virtual ~PendingFuture() {}
+  // Called on the waiter thread, true when the future is ready or deferred
+  virtual bool Wait(std::chrono::microseconds timeout) = 0;
+  // Called on the waiter thread when the future is ready
+  virtual void Get() = 0;
+  // Called on the main thread
+  virtual void Settle() = 0;
+  // Called on the main thread by the environment cleanup hook
+  virtual void Abandon() = 0;
+};
+
+template <typename F, typename T, const ReturnAttribute &RETATTR> class PendingFutureImpl : public PendingFuture {
+  static_assert(!std::is_reference_v<T>, "Futures of references are not supported");
+
+  Napi::Env env_;
+  Napi::AsyncContext context_;
+  Napi::Promise::Deferred deferred_;
+  F future_;
+  std::optional<never_void_t<T>> result_;
+  std::optional<std::string> error_;
+
+public:
+  PendingFutureImpl(Napi::Env env, F &&future)
+      : env_(env), context_(env, "nobind_Future"), deferred_(Napi::Promise::Deferred::New(env)),
+        future_(std::move(future)) {}
+
+  Napi::Promise Promise() { return deferred_.Promise(); }
+
+  virtual bool Wait(std::chrono::microseconds timeout) override {
+    return future_.wait_for(timeout) != std::future_status::timeout;
+  }
+
+  virtual void Get() override {
+    try {
+      if constexpr (std::is_void_v<T>) {
+        future_.get();
+      } else {
+        result_.emplace(future_.get());
+      }
+    } catch (const std::exception &e) {
+      error_ = e.what();
+    } catch (...) {
+      error_ = "Unknown exception";
+    }
+  }
+
+  virtual void Settle() override {
+    Napi::HandleScope scope(env_);
+    Napi::CallbackScope callback(env_, context_);
+    if (error_.has_value()) {
+      deferred_.Reject(Napi::Error::New(env_, *error_).Value());
+      return;
+    }
+    try {
+      if constexpr (std::is_void_v<T>) {
+        deferred_.Resolve(env_.Undefined());
+      } else {
+        deferred_.Resolve(ToJS_t<T, RETATTR>(env_, *result_).Get());
+      }
+    } catch (const std::exception &e) {
+      deferred_.Reject(Napi::Error::New(env_, e.what()).Value());
+    }
+  }
+
+  virtual void Abandon() override {
+    try {
+      Napi::HandleScope scope(env_);
+      deferred_.Reject(Napi::Error::New(env_, "Environment is shutting down").Value());
+    } catch (...) {
+      // JS cannot run anymore, the Promise is simply released
+    }
+  }
+};
+
+// The per-environment waiter thread, started by the first future
+class FutureWaiter {
+  Napi::Env env_;
+  std::mutex lock_;
+  std::condition_variable cv_;
+  // Only the main thread adds futures and only the waiter thread removes them
+  std::list<std::unique_ptr<PendingFuture>> pending_;
+  // The futures with a result, waiting to be settled on the main thread
+  std::list<std::unique_ptr<PendingFuture>> ready_;
+  // New futures have been added since the last check
+  bool added_;
+  bool stop_;
+  std::thread thread_;
+
+  void Run() {
+    std::unique_lock<std::mutex> guard{lock_};
+    auto interval = std::chrono::microseconds(NOBIND_FUTURE_POLL);
+    while (true) {
+      cv_.wait(guard, [this]() { return stop_ || !pending_.empty(); });
+      if (stop_)
+        return;
+      if (added_) {
+        added_ = false;
+        interval = std::chrono::microseconds(NOBIND_FUTURE_POLL);
+      }
+      std::vector<std::unique_ptr<PendingFuture>> ready;
+      for (auto it = pending_.begin(); it != pending_.end();) {
+        if ((*it)->Wait(std::chrono::microseconds::zero())) {
+          ready.push_back(std::move(*it));
+          it = pending_.erase(it);
+        } else {
+          it++;
+        }
+      }
+      if (ready.empty()) {
+        // The oldest future stays at the front while unlocked
+        PendingFuture *oldest = pending_.front().get();
+        guard.unlock();
+        bool done = oldest->Wait(interval);
+        guard.lock();
+        if (done) {
+          ready.push_back(std::move(pending_.front()));
+          pending_.pop_front();
+        } else {
+          interval = std::min(interval * 2, std::chrono::microseconds(NOBIND_FUTURE_POLL_MAX));
+          continue;
+        }
+      }
+      interval = std::chrono::microseconds(NOBIND_FUTURE_POLL);
+      guard.unlock();
+      for (auto &future : ready)
+        future->Get();
+      guard.lock();
+      for (auto &future : ready)
+        ready_.push_back(std::move(future));
+      // Settled on the main thread, unless the environment is destroyed before
+      RunOnJSMainThread<BaseEnvInstanceData>(env_, [env = env_]() {
+        FutureWaiter *waiter = env.GetInstanceData<BaseEnvInstanceData>()->_Nobind_future_waiter;
+        if (waiter != nullptr)
+          waiter->SettleReady();
+      });
+    }
+  }
+
+  // Called on the main thread
+  void SettleReady() {
+    std::list<std::unique_ptr<PendingFuture>> ready;
+    {
+      std::lock_guard<std::mutex> guard{lock_};
+      std::swap(ready, ready_);
+    }
+    for (auto &future : ready) {
+      future->Settle();
+      ReleaseEventLoop(env_.GetInstanceData<BaseEnvInstanceData>());
+    }
+  }
+
+public:
+  explicit FutureWaiter(Napi::Env env)
+      : env_(env), added_(false), stop_(false), thread_([this]() { Run(); }) {}
+
+  // Called by the environment cleanup hook, the waiter thread finishes
+  // its current wait, at most NOBIND_FUTURE_POLL_MAX microseconds
+  ~FutureWaiter() {
+    {
+      std::lock_guard<std::mutex> guard{lock_};
+      stop_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+    // The environment is being destroyed, the Promises will never be settled
+    // (destroying the future of a std::async task waits for the task)
+    for (auto &future : ready_)
+      future->Abandon();
+    for (auto &future : pending_)
+      future->Abandon();
+  }
+
+  // Called on the main thread, the event loop is kept alive until the Promise is settled
+  void Add(std::unique_ptr<PendingFuture> &&future) {
+    KeepEventLoopAlive(env_.GetInstanceData<BaseEnvInstanceData>());
+    {
+      std::lock_guard<std::mutex> guard{lock_};
+      pending_.push_back(std::move(future));
+      added_ = true;
+    }
+    cv_.notify_one();
+  }
+};
+
+template <typename T = BaseEnvInstanceData> FutureWaiter &GetFutureWaiter(Napi::Env env) {
+  auto instance = env.GetInstanceData<T>();
+  if (instance->_Nobind_future_waiter == nullptr)
+    instance->_Nobind_future_waiter = new FutureWaiter(env);
+  return *instance->_Nobind_future_waiter;
+}
+
+namespace Typemap {
+
+// C++ std::future / std::shared_future -> JS Promise
+template <typename F, typename T, const ReturnAttribute &RETATTR> class ToJSFuture {
+  Napi::Env env_;
+  F val_;
+
+public:
+  NOBIND_INLINE explicit ToJSFuture(Napi::Env env, F &val) : env_(env), val_(std::move(val)) {}
+  NOBIND_INLINE Napi::Value Get() {
+    if (!val_.valid())
+      throw Napi::Error::New(env_, "Invalid future");
+    auto pending = std::make_unique<PendingFutureImpl<F, T, RETATTR>>(env_, std::move(val_));
+    Napi::Promise promise = pending->Promise();
+    GetFutureWaiter(env_).Add(std::move(pending));
+    return promise;
+  }
+
+  static std::string TSType() { return "Promise<"s + ToTSType<T, RETATTR>() + ">"s; }
+};
+
+template <typename T, const ReturnAttribute &RETATTR>
+class ToJS<std::future<T>, RETATTR> : public ToJSFuture<std::future<T>, T, RETATTR> {
+public:
+  using ToJSFuture<std::future<T>, T, RETATTR>::ToJSFuture;
+};
+
+template <typename T, const ReturnAttribute &RETATTR>
+class ToJS<std::shared_future<T>, RETATTR> : public ToJSFuture<std::shared_future<T>, T, RETATTR> {
+public:
+  using ToJSFuture<std::shared_future<T>, T, RETATTR>::ToJSFuture;
+};
+
+} // namespace Typemap
+
+} // namespace Nobind
@@ -1,5 +1,8 @@
+#pragma once
 #include "nonapi.h"
 #include <functional>
+#include <mutex>
+#include <queue>
 #include <thread>
 
 // This standard construct (schedule a job to run on the
@@ -16,11 +19,15 @@ namespace Nobind {
 template <typename T> void RunMainThreadQueue(uv_async_t *async) {
   auto env_data = reinterpret_cast<T *>(async->data);
 
-  // As the lambdas are very light, it is better to not release the lock at all
-  std::lock_guard<std::mutex> lock(env_data->_Nobind_js_thread_jobs_lock);
-  while (!env_data->_Nobind_js_thread_jobs.empty()) {
-    env_data->_Nobind_js_thread_jobs.front()();
-    env_data->_Nobind_js_thread_jobs.pop();
+  // The jobs can schedule new jobs, these will run on the next iteration
+  std::queue<std::function<void()>> jobs;
+  {
+    std::lock_guard<std::mutex> lock(env_data->_Nobind_js_thread_jobs_lock);
+    std::swap(jobs, env_data->_Nobind_js_thread_jobs);
+  }
+  while (!jobs.empty()) {
+    jobs.front()();
+    jobs.pop();
   }
 }
 
@@ -66,4 +73,37 @@ template <typename T> void RunOnJSMainThread(Napi::BasicEnv env, std::function<v
       std::abort();
   }
 }
+
+/* ---------------------------------------------------------------------------
+ * Keep the event loop alive until the matching ReleaseEventLoop,
+ * both are called on the main thread
+ * ---------------------------------------------------------------------------*/
+template <typename T> void KeepEventLoopAlive(T *env_data) {
+  if (env_data->_Nobind_js_thread_yields++ == 0)
+    uv_ref(reinterpret_cast<uv_handle_t *>(env_data->_Nobind_js_thread_async_handle));
+}
+
+template <typename T> void ReleaseEventLoop(T *env_data) {
+  if (--env_data->_Nobind_js_thread_yields == 0)
+    uv_unref(reinterpret_cast<uv_handle_t *>(env_data->_Nobind_js_thread_async_handle));
+}
+
+/* ---------------------------------------------------------------------------
+ * Schedule a job to run on the main thread on the next iteration of the
+ * event loop, the event loop is kept alive until the job runs
+ * ---------------------------------------------------------------------------*/
+template <typename T> void YieldToEventLoop(Napi::Env env, std::function<void()> &&job) {
+  auto env_data = env.GetInstanceData<T>();
+  // Only the main thread yields, only the queue needs locking
+  KeepEventLoopAlive(env_data);
+  {
+    std::lock_guard<std::mutex> lock(env_data->_Nobind_js_thread_jobs_lock);
+    env_data->_Nobind_js_thread_jobs.emplace([env_data, job = std::move(job)]() {
+      ReleaseEventLoop(env_data);
+      job();
+    });
+  }
+  if (uv_async_send(env_data->_Nobind_js_thread_async_handle) != 0)
+    std::abort();
+}
 }; // namespace Nobind
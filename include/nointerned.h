@@ -0,0 +1,80 @@
+#pragma once
+#include <nodebug.h>
+#include <nonapi.h>
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#ifndef NOBIND_INTERNED_STRINGS_MAX
+#define NOBIND_INTERNED_STRINGS_MAX 1024
+#endif
+
+namespace Nobind {
+
+// Creates strong references to JS strings
+//
+// Referencing strings requires Node-API with NAPI_EXPERIMENTAL or version 10,
+// with older versions the first attempt fails and the callers fall back to
+// recreating their strings on every use.
+class StringReferences {
+  bool supported_;
+
+public:
+  StringReferences() : supported_{true} {}
+
+  // Returns an empty reference if strings cannot be referenced
+  NOBIND_INLINE Napi::Reference<Napi::Value> New(Napi::Value js) {
+    napi_ref ref;
+    if (!supported_)
+      return Napi::Reference<Napi::Value>{};
+    if (napi_create_reference(js.Env(), js, 1, &ref) != napi_ok) {
+      NOBIND_VERBOSE(STORE, "this Node-API version cannot reference strings, they will be recreated on every use\n");
+      supported_ = false;
+      return Napi::Reference<Napi::Value>{};
+    }
+    return Napi::Reference<Napi::Value>(js.Env(), ref);
+  }
+};
+
+// The per-environment table of ReturnInterned strings
+//
+// Every C++ string is mapped to a strong reference to its JS string,
+// returning the same C++ string again reuses the existing JS string
+// instead of allocating a new one.
+//
+// The table is meant for small closed sets of strings such as enum names,
+// once it reaches NOBIND_INTERNED_STRINGS_MAX entries, new strings are not
+// interned anymore. It is freed by the environment cleanup hook.
+class InternedStrings {
+  // The keys of the table point to these strings, std::deque never moves its elements
+  std::deque<std::string> keys_;
+  std::unordered_map<std::string_view, Napi::Reference<Napi::Value>> table_;
+  StringReferences refs_;
+
+public:
+  InternedStrings() : keys_{}, table_{}, refs_{} {}
+  InternedStrings(const InternedStrings &) = delete;
+
+  // Returns an empty value if the string is not interned
+  NOBIND_INLINE Napi::Value Get(std::string_view key) {
+    auto el = table_.find(key);
+    if (el == table_.end())
+      return Napi::Value{};
+    return el->second.Value();
+  }
+
+  NOBIND_INLINE void Put(std::string_view key, Napi::Value js) {
+    if (table_.size() >= NOBIND_INTERNED_STRINGS_MAX)
+      return;
+    Napi::Reference<Napi::Value> ref = refs_.New(js);
+    if (ref.IsEmpty())
+      return;
+    keys_.emplace_back(key);
+    table_.emplace(keys_.back(), std::move(ref));
+  }
+};
+
+} // namespace Nobind
@@ -6,6 +6,7 @@
 // * for complex or non-copyable objects the only solution is to return the
 //   reference itself and keep a reference to the container in the JS object
 
+#include <nokeys.h>
 #include <notypes.h>
 
 namespace Nobind {
@@ -50,7 +51,7 @@ public:
 
     JSIteratorResult<value_type_t> ret = Napi::Object::New(env);
     if (this->it == this->target.end()) {
-      ret.Set("done", Napi::Boolean::New(env, true));
+      ret.Set(PropertyKey<key_done>(env), Napi::Boolean::New(env, true));
     } else {
       Napi::Value value;
       if constexpr (RETATTR.isNested()) {
@@ -59,12 +60,12 @@ public:
         // Thus, the container can be destroyed only after all returned objects and
         // the iterator have been GCed
         value.ToObject().DefineProperty(
-            Napi::PropertyDescriptor::Value(Napi::String::New(env, NOBIND_PARENT_PROP), persistent->Value()));
+            Napi::PropertyDescriptor::Value(PropertyKey<key_parent>(env), persistent->Value()));
       } else {
         value = Nobind::ToJS<value_type_t, RETATTR>(env, *it).Get();
       }
-      ret.Set("value", value);
-      ret.Set("done", Napi::Boolean::New(env, false));
+      ret.Set(PropertyKey<key_value>(env), value);
+      ret.Set(PropertyKey<key_done>(env), Napi::Boolean::New(env, false));
       it++;
     }
     return ret;
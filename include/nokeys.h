@@ -0,0 +1,87 @@
+#pragma once
+#include <nodebug.h>
+#include <nonapi.h>
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nointerned.h>
+#include <notypes.h>
+
+namespace Nobind {
+
+struct BaseEnvInstanceData;
+
+// The property names used by nobind17 itself
+inline constexpr char key_done[] = "done";
+inline constexpr char key_value[] = "value";
+inline constexpr char key_parent[] = NOBIND_PARENT_PROP;
+inline constexpr char key_mirror[] = NOBIND_MIRROR_PROP;
+
+// Create a property key, when supported by Node-API, the string
+// is internalized once when it is created instead of on every use
+NOBIND_INLINE Napi::Value NewPropertyKey(Napi::Env env, const char *name, size_t len = NAPI_AUTO_LENGTH) {
+  napi_value r;
+#if defined(NODE_API_EXPERIMENTAL_HAS_PROPERTY_KEYS) || NAPI_VERSION >= 10
+  napi_status status = node_api_create_property_key_utf8(env, name, len, &r);
+#else
+  napi_status status = napi_create_string_utf8(env, name, len, &r);
+#endif
+  if (status != napi_ok) {
+    throw Napi::Error::New(env, "Failed to create a property key");
+  }
+  return Napi::Value(env, r);
+}
+
+// The per-environment cache of fixed property keys
+//
+// Every name passed to PropertyKey<NAME> and every field of a reflected struct
+// receives a unique index when it is first used and the cache keeps a strong
+// reference to its key.
+class PropertyKeys {
+  std::vector<Napi::Reference<Napi::Value>> keys_;
+  StringReferences refs_;
+
+public:
+  PropertyKeys() : keys_{}, refs_{} {}
+  PropertyKeys(const PropertyKeys &) = delete;
+
+  // Allocate n consecutive indices
+  static size_t Register(size_t n = 1) {
+    static std::atomic<size_t> count{0};
+    return count.fetch_add(n);
+  }
+
+  NOBIND_INLINE Napi::Value Get(Napi::Env env, size_t idx, const char *name) {
+    if (idx < keys_.size() && !keys_[idx].IsEmpty())
+      return keys_[idx].Value();
+    Napi::Value key = NewPropertyKey(env, name);
+    Napi::Reference<Napi::Value> ref = refs_.New(key);
+    if (!ref.IsEmpty()) {
+      if (idx >= keys_.size())
+        keys_.resize(idx + 1);
+      keys_[idx] = std::move(ref);
+    }
+    return key;
+  }
+};
+
+// Retrieve the cached property key at an index allocated by PropertyKeys::Register()
+template <typename INSTANCE = BaseEnvInstanceData>
+NOBIND_INLINE Napi::Value PropertyKey(Napi::Env env, size_t idx, const char *name) {
+  PropertyKeys *keys = env.GetInstanceData<INSTANCE>()->_Nobind_property_keys;
+  if (keys == nullptr)
+    return NewPropertyKey(env, name);
+  return keys->Get(env, idx, name);
+}
+
+// Retrieve the cached property key for a fixed property name
+// (NAME must be a constant with linkage, ie constexpr char name[] = "name")
+template <const char *NAME> NOBIND_INLINE Napi::Value PropertyKey(Napi::Env env) {
+  static const size_t idx = PropertyKeys::Register();
+  return PropertyKey(env, idx, NAME);
+}
+
+} // namespace Nobind
@@ -0,0 +1,205 @@
+#pragma once
+#include <nonapi.h>
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <noattributes.h>
+#include <nohelpers.h>
+
+#ifndef NOBIND_LIMITS_PROP
+#define NOBIND_LIMITS_PROP "__limits"
+#endif
+
+namespace Nobind {
+
+struct BaseEnvInstanceData;
+
+// In-flight limits of async calls
+//
+// A binding with ReturnLimit<MAX> never has more than MAX tasklets queued or
+// running at the same time. The excess calls keep only their unconverted JS
+// arguments and their Promise in a waiting queue on the nobind17 side. When a
+// tasklet is destroyed, its slot is handed over to the oldest waiting call that
+// is replayed through the binding on the next iteration of the event loop.
+// The calls still waiting when the environment is destroyed are rejected.
+class AsyncLimiter {
+  struct Waiting {
+    Napi::Promise::Deferred deferred;
+    Napi::Reference<Napi::Array> args;
+    Napi::Reference<Napi::Value> self;
+  };
+
+  Napi::Env env_;
+  Napi::AsyncContext context_;
+  // The binding, called again to replay the waiting calls
+  Napi::FunctionReference replay_;
+  std::size_t max_;
+  ReturnAttribute::Overflow policy_;
+  std::size_t inflight_;
+  // A slot released by a finished call that is reserved for the next replayed call
+  bool handoff_;
+  std::deque<Waiting> waiting_;
+  uint64_t rejected_, dropped_;
+
+  void Replay() {
+    // Several calls finished in the same iteration and an earlier replay
+    // has already taken the last waiting call, the slot is free
+    if (waiting_.empty()) {
+      inflight_--;
+      return;
+    }
+    Napi::HandleScope scope(env_);
+    Napi::CallbackScope callback(env_, context_);
+    Waiting next = std::move(waiting_.front());
+    waiting_.pop_front();
+    Napi::Array array = next.args.Value();
+    std::vector<napi_value> args;
+    for (uint32_t i = 0; i < array.Length(); i++)
+      args.push_back(array.Get(i));
+    handoff_ = true;
+    try {
+      next.deferred.Resolve(replay_.Value().Call(next.self.Value(), args));
+    } catch (const std::exception &e) {
+      next.deferred.Reject(Napi::Error::New(env_, e.what()).Value());
+    }
+    // In case the replayed call did not reach Acquire()
+    if (handoff_) {
+      handoff_ = false;
+      Release();
+    }
+  }
+
+public:
+  AsyncLimiter(Napi::Env env, Napi::Function replay, std::size_t max, ReturnAttribute::Overflow policy)
+      : env_(env), context_(env, "nobind_AsyncLimiter"), replay_(Napi::Persistent(replay)), max_(max),
+        policy_(policy), inflight_(0), handoff_(false), waiting_(), rejected_(0), dropped_(0) {}
+
+  // Reserve a slot for a new call, returns false if the limit has been reached
+  bool Acquire() {
+    if (handoff_) {
+      handoff_ = false;
+      return true;
+    }
+    if (inflight_ < max_ && waiting_.empty()) {
+      inflight_++;
+      return true;
+    }
+    return false;
+  }
+
+  // Free the slot of a finished call, or hand it over to the oldest waiting call
+  void Release() {
+    if (waiting_.empty()) {
+      inflight_--;
+      return;
+    }
+    YieldToEventLoop<BaseEnvInstanceData>(env_, [this]() { Replay(); });
+  }
+
+  // Keep a call that has been refused a slot, returns its Promise
+  Napi::Value Wait(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (policy_ == ReturnAttribute::Reject) {
+      rejected_++;
+      deferred.Reject(Napi::RangeError::New(env, "Too many calls in flight").Value());
+      return deferred.Promise();
+    }
+    if (policy_ == ReturnAttribute::DropOldest && waiting_.size() >= max_) {
+      dropped_++;
+      waiting_.front().deferred.Reject(Napi::RangeError::New(env, "Dropped by a newer call").Value());
+      waiting_.pop_front();
+    }
+    Napi::Array args = Napi::Array::New(env, info.Length());
+    for (std::size_t i = 0; i < info.Length(); i++)
+      args.Set(static_cast<uint32_t>(i), info[i]);
+    waiting_.push_back({deferred, Napi::Persistent(args), Napi::Persistent(info.This())});
+    return deferred.Promise();
+  }
+
+  // Called by the environment cleanup hook, the waiting calls will never be replayed
+  void Drain() {
+    while (!waiting_.empty()) {
+      try {
+        Napi::HandleScope scope(env_);
+        waiting_.front().deferred.Reject(Napi::Error::New(env_, "Environment is shutting down").Value());
+      } catch (...) {
+        // JS cannot run anymore, the Promise is simply released
+      }
+      waiting_.pop_front();
+    }
+  }
+
+  Napi::Object ToJS(Napi::Env env) const {
+    Napi::Object r = Napi::Object::New(env);
+    r.Set("max", Napi::Number::New(env, static_cast<double>(max_)));
+    r.Set("inflight", Napi::Number::New(env, static_cast<double>(inflight_)));
+    r.Set("queued", Napi::Number::New(env, static_cast<double>(waiting_.size())));
+    r.Set("rejected", Napi::Number::New(env, static_cast<double>(rejected_)));
+    r.Set("dropped", Napi::Number::New(env, static_cast<double>(dropped_)));
+    return r;
+  }
+};
+
+// Holds the slot of a call, releases it when the tasklet is destroyed
+class AsyncLimiterSlot {
+  AsyncLimiter *limiter_;
+
+public:
+  AsyncLimiterSlot() : limiter_(nullptr) {}
+  explicit AsyncLimiterSlot(AsyncLimiter *limiter) : limiter_(limiter) {}
+  AsyncLimiterSlot(const AsyncLimiterSlot &) = delete;
+  AsyncLimiterSlot(AsyncLimiterSlot &&other) : limiter_(other.limiter_) { other.limiter_ = nullptr; }
+  AsyncLimiterSlot &operator=(AsyncLimiterSlot &&other) {
+    std::swap(limiter_, other.limiter_);
+    return *this;
+  }
+  ~AsyncLimiterSlot() {
+    if (limiter_)
+      limiter_->Release();
+  }
+};
+
+// The identity of a limited binding
+template <auto FUNC, const ReturnAttribute &RETATTR> const void *AsyncLimiterKey() {
+  static const char key = 0;
+  return &key;
+}
+
+// The per-environment limiters and the list of the limited bindings, for NOBIND_LIMITS_PROP
+struct AsyncLimiters {
+  std::unordered_map<const void *, AsyncLimiter> limiters;
+  std::vector<std::pair<std::string, const AsyncLimiter *>> bindings;
+
+  template <auto FUNC, const ReturnAttribute &RETATTR>
+  void Add(Napi::Env env, std::string name, Napi::Function replay) {
+    auto it = limiters.try_emplace(AsyncLimiterKey<FUNC, RETATTR>(), env, replay, RETATTR.Limit(), RETATTR.Policy());
+    bindings.emplace_back(std::move(name), &it.first->second);
+  }
+
+  void Drain() {
+    for (auto &limiter : limiters)
+      limiter.second.Drain();
+  }
+};
+
+template <auto FUNC, const ReturnAttribute &RETATTR, typename T = BaseEnvInstanceData>
+AsyncLimiter &GetAsyncLimiter(Napi::Env env) {
+  return env.GetInstanceData<T>()->_Nobind_async_limiters.limiters.at(AsyncLimiterKey<FUNC, RETATTR>());
+}
+
+inline Napi::Value AsyncLimitsGetter(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  Napi::Object r = Napi::Object::New(env);
+  auto limits = static_cast<AsyncLimiters *>(info.Data());
+  for (const auto &binding : limits->bindings)
+    r.Set(binding.first, binding.second->ToJS(env));
+  return r;
+}
+
+} // namespace Nobind
@@ -0,0 +1,189 @@
+#pragma once
+#include <nonapi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef NOBIND_MEMOIZE_SIZE
+#define NOBIND_MEMOIZE_SIZE 256
+#endif
+
+#ifndef NOBIND_MEMOIZE_PROP
+#define NOBIND_MEMOIZE_PROP "__memoized"
+#endif
+
+namespace Nobind {
+
+// Memoization of pure functions
+//
+// Every ReturnMemoized binding has a bounded LRU cache of its results indexed
+// by its converted C++ arguments. A hit skips the C++ call and, in async mode,
+// the whole tasklet. Only arithmetic and string arguments and returned values
+// are supported. The caches are shared by all threads and environments and by
+// all the bindings of the same C++ function.
+
+// The type of the argument in the key
+template <typename T, typename = void> struct MemoKey {
+  static_assert(!std::is_same_v<T, T>, "Memoized functions support only arithmetic and string arguments");
+};
+template <typename T>
+struct MemoKey<T, std::enable_if_t<std::is_arithmetic_v<std::remove_cv_t<std::remove_reference_t<T>>> ||
+                                   std::is_enum_v<std::remove_cv_t<std::remove_reference_t<T>>>>> {
+  using type = std::remove_cv_t<std::remove_reference_t<T>>;
+};
+template <typename T>
+struct MemoKey<T, std::enable_if_t<std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, std::string> ||
+                                   std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, std::string_view>>> {
+  using type = std::string;
+};
+template <typename... ARGS> using MemoKey_t = std::tuple<typename MemoKey<ARGS>::type...>;
+
+// The key of an async call, built once and kept until its result is stored
+template <bool MEMOIZED, typename... ARGS> struct MemoKeyHolder {
+  using type = std::nullptr_t;
+};
+template <typename... ARGS> struct MemoKeyHolder<true, ARGS...> {
+  using type = std::optional<MemoKey_t<ARGS...>>;
+};
+
+// The cached returned value
+template <typename T> using MemoValue_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+template <typename KEY> struct MemoHash {
+  template <std::size_t... I> static std::size_t Hash(const KEY &key, std::index_sequence<I...>) {
+    std::size_t r = 0;
+    // boost::hash_combine
+    ((r ^= std::hash<std::tuple_element_t<I, KEY>>{}(std::get<I>(key)) + 0x9e3779b9 + (r << 6) + (r >> 2)), ...);
+    return r;
+  }
+  std::size_t operator()(const KEY &key) const {
+    return Hash(key, std::make_index_sequence<std::tuple_size_v<KEY>>{});
+  }
+};
+
+class MemoCacheBase {
+protected:
+  std::mutex lock_;
+  uint64_t hits_ = 0, misses_ = 0, evictions_ = 0;
+
+public:
+  virtual ~MemoCacheBase() {}
+  virtual std::size_t Size() = 0;
+  virtual void Clear() = 0;
+
+  Napi::Object ToJS(Napi::Env env) {
+    Napi::Object r = Napi::Object::New(env);
+    std::size_t size = Size();
+    std::lock_guard<std::mutex> guard{lock_};
+    r.Set("hits", Napi::Number::New(env, static_cast<double>(hits_)));
+    r.Set("misses", Napi::Number::New(env, static_cast<double>(misses_)));
+    r.Set("evictions", Napi::Number::New(env, static_cast<double>(evictions_)));
+    r.Set("size", Napi::Number::New(env, static_cast<double>(size)));
+    r.Set("clear", Napi::Function::New(
+                       env,
+                       [](const Napi::CallbackInfo &info) {
+                         static_cast<MemoCacheBase *>(info.Data())->Clear();
+                         return info.Env().Undefined();
+                       },
+                       "clear", this));
+    return r;
+  }
+};
+
+template <typename KEY, typename VALUE> class MemoCache : public MemoCacheBase {
+  // Most recently used first
+  std::list<std::pair<KEY, VALUE>> entries_;
+  std::unordered_map<KEY, typename std::list<std::pair<KEY, VALUE>>::iterator, MemoHash<KEY>> index_;
+
+public:
+  std::optional<VALUE> Find(const KEY &key) {
+    std::lock_guard<std::mutex> guard{lock_};
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      misses_++;
+      return std::nullopt;
+    }
+    hits_++;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  // Two concurrent misses of the same key can both store their result
+  void Store(KEY &&key, const VALUE &value) {
+    std::lock_guard<std::mutex> guard{lock_};
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      it->second->second = value;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    entries_.emplace_front(std::move(key), value);
+    index_.emplace(entries_.front().first, entries_.begin());
+    if (entries_.size() > NOBIND_MEMOIZE_SIZE) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+      evictions_++;
+    }
+  }
+
+  virtual std::size_t Size() override {
+    std::lock_guard<std::mutex> guard{lock_};
+    return entries_.size();
+  }
+
+  // Also resets the statistics
+  virtual void Clear() override {
+    std::lock_guard<std::mutex> guard{lock_};
+    index_.clear();
+    entries_.clear();
+    hits_ = misses_ = evictions_ = 0;
+  }
+};
+
+template <auto FUNC, typename RETURN, typename... ARGS>
+MemoCache<MemoKey_t<ARGS...>, MemoValue_t<RETURN>> &Memoized() {
+  static_assert(!std::is_void_v<RETURN>, "Memoized functions must return a value");
+  static_assert(std::is_arithmetic_v<MemoValue_t<RETURN>> || std::is_enum_v<MemoValue_t<RETURN>> ||
+                    std::is_same_v<MemoValue_t<RETURN>, std::string>,
+                "Memoized functions support only arithmetic and string returned values");
+  static MemoCache<MemoKey_t<ARGS...>, MemoValue_t<RETURN>> cache;
+  return cache;
+}
+
+// The cache of a function, for the registration of the binding
+template <typename RETURN, typename... ARGS, RETURN (*FUNC)(ARGS...)>
+MemoCacheBase &MemoizedFunction(std::integral_constant<RETURN (*)(ARGS...), FUNC>) {
+  return Memoized<FUNC, RETURN, ARGS...>();
+}
+template <typename RETURN, typename... ARGS, RETURN (*FUNC)(ARGS...) noexcept>
+MemoCacheBase &MemoizedFunction(std::integral_constant<RETURN (*)(ARGS...) noexcept, FUNC>) {
+  return Memoized<FUNC, RETURN, ARGS...>();
+}
+template <auto *FUNC> MemoCacheBase &MemoizedFunction() {
+  return MemoizedFunction(std::integral_constant<decltype(FUNC), FUNC>{});
+}
+
+// The per-environment list of the memoized bindings, for NOBIND_MEMOIZE_PROP
+using MemoBindings = std::vector<std::pair<std::string, MemoCacheBase *>>;
+
+inline Napi::Value MemoStatsGetter(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  Napi::Object r = Napi::Object::New(env);
+  auto bindings = static_cast<MemoBindings *>(info.Data());
+  for (const auto &binding : *bindings)
+    r.Set(binding.first, binding.second->ToJS(env));
+  return r;
+}
+
+} // namespace Nobind
@@ -0,0 +1,129 @@
+#pragma once
+#include <nodebug.h>
+#include <nonapi.h>
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <notypes.h>
+
+namespace Nobind {
+
+// Mirrored classes
+//
+// The C++ objects of a mirrored class are viewed through an external ArrayBuffer
+// that does not own them, so it can be detached from JS. Each JS object
+// holds a DataView of its C++ object and its number fields are JS accessors reading
+// and writing through this DataView at fixed offsets - the JIT can inline these
+// without calling into C++.
+
+// Number fields, other than char and long double, can be mirrored
+template <typename T>
+constexpr bool IsMirroredField_v = std::is_arithmetic_v<T> && !std::is_same_v<T, char> && sizeof(T) <= 8;
+
+// The DataView method suffix for a number type
+template <typename T> constexpr const char *MirrorDataViewType() {
+  static_assert(IsMirroredField_v<T>, "Type cannot be mirrored");
+  if constexpr (std::is_same_v<T, bool>) {
+    return "Uint8";
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return sizeof(T) == 4 ? "Float32" : "Float64";
+  } else if constexpr (std::is_signed_v<T>) {
+    switch (sizeof(T)) {
+    case 1:
+      return "Int8";
+    case 2:
+      return "Int16";
+    case 4:
+      return "Int32";
+    default:
+      return "BigInt64";
+    }
+  } else {
+    switch (sizeof(T)) {
+    case 1:
+      return "Uint8";
+    case 2:
+      return "Uint16";
+    case 4:
+      return "Uint32";
+    default:
+      return "BigUint64";
+    }
+  }
+}
+
+// A field of a mirrored class, idx is the position of its native accessor
+// in the class properties, it is replaced by the JS accessor
+struct MirroredField {
+  std::string name;
+  size_t offset;
+  const char *type;
+  bool is_bool;
+  bool read_only;
+  size_t idx;
+};
+
+// Escape a string for a double-quoted JS string literal
+NOBIND_INLINE std::string MirrorQuote(const std::string &s) {
+  std::string r;
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      r += '\\';
+    r += c;
+  }
+  return r;
+}
+
+// The JS accessors of a field
+NOBIND_INLINE std::string MirrorAccessorSource(const MirroredField &field) {
+  static const uint16_t endianness = 1;
+  static const std::string little_endian =
+      *reinterpret_cast<const uint8_t *>(&endianness) == 1 ? "true"s : "false"s;
+  const std::string view = "this." NOBIND_MIRROR_PROP;
+  const std::string offset = std::to_string(field.offset);
+  const std::string type{field.type};
+  const bool big = type.rfind("Big", 0) == 0;
+
+  std::string getter = view + ".get"s + type + "("s + offset + ", "s + little_endian + ")"s;
+  if (field.is_bool)
+    getter = getter + " !== 0"s;
+  else if (big)
+    getter = "Number("s + getter + ")"s;
+
+  std::string src = "get() { return "s + getter + "; }, "s;
+  if (!field.read_only) {
+    std::string value = field.is_bool ? "v ? 1 : 0"s : big ? "BigInt(Math.trunc(v))"s : "v"s;
+    std::string expected = field.is_bool ? "boolean"s : "number"s;
+    src += "set(v) { if (typeof v !== '"s + expected + "') throw new TypeError('Expected a "s + expected + "'); "s +
+           view + ".set"s + type + "("s + offset + ", "s + value + ", "s + little_endian + "); }, "s;
+  } else {
+    // Same error as assigning a native read-only accessor in strict mode
+    src += "set(v) { throw new TypeError(\"Cannot set property "s + MirrorQuote(field.name) +
+           " of #<\" + this.constructor.name + \"> which has only a getter\"); }, "s;
+  }
+  return src;
+}
+
+// Define the JS accessors of the mirrored fields on the class prototype
+NOBIND_INLINE void DefineMirroredFields(Napi::Env env, Napi::Function ctor, const std::vector<MirroredField> &fields) {
+  if (fields.empty())
+    return;
+  std::string src = "({"s;
+  for (const auto &field : fields) {
+    src += "\""s + MirrorQuote(field.name) + "\": { "s + MirrorAccessorSource(field) +
+           "enumerable: false, configurable: false },\n"s;
+  }
+  src += "})"s;
+
+  napi_value descriptors;
+  if (napi_run_script(env, Napi::String::New(env, src), &descriptors) != napi_ok) {
+    throw Napi::Error::New(env, "Failed to create the mirrored accessors");
+  }
+  Napi::Object Object = env.Global().Get("Object").ToObject();
+  Object.Get("defineProperties").As<Napi::Function>().Call(Object, {ctor.Get("prototype"), descriptors});
+}
+
+} // namespace Nobind
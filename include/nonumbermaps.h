@@ -109,6 +109,73 @@ public:
   ToJSDouble(ToJSDouble &&) = default;
 };
 
+// The Node-API getters for each JS number representation
+struct NapiGetInt32 {
+  using type = int32_t;
+  static NOBIND_INLINE napi_status Get(napi_env env, napi_value val, type *r) {
+    return napi_get_value_int32(env, val, r);
+  }
+};
+struct NapiGetUint32 {
+  using type = uint32_t;
+  static NOBIND_INLINE napi_status Get(napi_env env, napi_value val, type *r) {
+    return napi_get_value_uint32(env, val, r);
+  }
+};
+struct NapiGetInt64 {
+  using type = int64_t;
+  static NOBIND_INLINE napi_status Get(napi_env env, napi_value val, type *r) {
+    return napi_get_value_int64(env, val, r);
+  }
+};
+struct NapiGetDouble {
+  using type = double;
+  static NOBIND_INLINE napi_status Get(napi_env env, napi_value val, type *r) {
+    return napi_get_value_double(env, val, r);
+  }
+};
+
+const std::string coerced_number_tstype = "number | string | boolean | null | undefined"s;
+
+// Number conversion following the JS semantics, ie Number(val)
+template <typename T, typename GETTER> class FromJSNumberCoerce {
+  T val_;
+
+public:
+  NOBIND_INLINE explicit FromJSNumberCoerce(const Napi::Value &val) {
+    Napi::Number number = val.ToNumber();
+    typename GETTER::type v;
+    if (GETTER::Get(val.Env(), number, &v) != napi_ok) {
+      throw Napi::TypeError::New(val.Env(), "Expected a number");
+    }
+    val_ = static_cast<T>(v);
+  }
+  NOBIND_INLINE T Get() { return val_; }
+  FromJSNumberCoerce(const FromJSNumberCoerce &) = delete;
+  FromJSNumberCoerce(FromJSNumberCoerce &&) = default;
+
+  static const std::string &TSType() { return coerced_number_tstype; }
+};
+
+// Number conversion with a single Node-API call, Node-API checks the type
+template <typename T, typename GETTER> class FromJSNumberUnchecked {
+  T val_;
+
+public:
+  NOBIND_INLINE explicit FromJSNumberUnchecked(const Napi::Value &val) {
+    typename GETTER::type v;
+    if (GETTER::Get(val.Env(), val, &v) != napi_ok) {
+      throw Napi::TypeError::New(val.Env(), "Expected a number");
+    }
+    val_ = static_cast<T>(v);
+  }
+  NOBIND_INLINE T Get() { return val_; }
+  FromJSNumberUnchecked(const FromJSNumberUnchecked &) = delete;
+  FromJSNumberUnchecked(FromJSNumberUnchecked &&) = default;
+
+  static const std::string TSType() { return "number"s; }
+};
+
 #define TYPEMAPS_FOR_NUMBER(CTYPE, JSTYPE)                                                                             \
   template <> class FromJS<CTYPE> : public FromJS##JSTYPE<CTYPE> {                                                     \
   public:                                                                                                              \
@@ -120,6 +187,16 @@ public:
   public:                                                                                                              \
     using ToJS##JSTYPE<CTYPE, RETATTR>::ToJS##JSTYPE;                                                                  \
     static const std::string TSType() { return "number"s; }                                                            \
+  };                                                                                                                   \
+                                                                                                                       \
+  template <> class FromJSCoerce<CTYPE> : public FromJSNumberCoerce<CTYPE, NapiGet##JSTYPE> {                          \
+  public:                                                                                                              \
+    using FromJSNumberCoerce<CTYPE, NapiGet##JSTYPE>::FromJSNumberCoerce;                                              \
+  };                                                                                                                   \
+                                                                                                                       \
+  template <> class FromJSUnchecked<CTYPE> : public FromJSNumberUnchecked<CTYPE, NapiGet##JSTYPE> {                    \
+  public:                                                                                                              \
+    using FromJSNumberUnchecked<CTYPE, NapiGet##JSTYPE>::FromJSNumberUnchecked;                                        \
   }
 
 TYPEMAPS_FOR_NUMBER(int, Int32);
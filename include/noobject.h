@@ -8,14 +8,23 @@
 #include <iostream>
 #include <nonapi.h>
 #include <numeric>
+#include <optional>
 #include <queue>
 #include <thread>
 #include <tuple>
 #include <type_traits>
 
+#include <nobatch.h>
+#include <nocancel.h>
 #include <nodebug.h>
 #include <nofunction.h>
+#include <nointerned.h>
+#include <nokeys.h>
+#include <nolimit.h>
+#include <nomemo.h>
+#include <nomirror.h>
 #include <noobjectstore.h>
+#include <nopriority.h>
 #include <notypes.h>
 #include <notypescript.h>
 
@@ -26,6 +35,7 @@ using namespace std::literals::string_literals;
 namespace Nobind {
 
 struct EmptyEnvInstanceData {};
+class FutureWaiter;
 
 struct BaseEnvInstanceData {
 #ifndef NOBIND_NO_OBJECT_STORE
@@ -35,7 +45,23 @@ struct BaseEnvInstanceData {
   uv_async_t *_Nobind_js_thread_async_handle;
   std::queue<std::function<void()>> _Nobind_js_thread_jobs;
   std::mutex _Nobind_js_thread_jobs_lock;
+  // Jobs keeping the event loop alive
+  size_t _Nobind_js_thread_yields = 0;
+  // The statistics of the ReturnAdaptive bindings
+  AdaptiveBindings _Nobind_adaptive_bindings;
+  // The caches of the ReturnMemoized bindings
+  MemoBindings _Nobind_memoized_bindings;
+  // The in-flight limits of the ReturnLimit bindings
+  AsyncLimiters _Nobind_async_limiters;
+  // The priority lanes of the ReturnPriority bindings
+  AsyncDispatcher _Nobind_async_dispatcher;
+  // The waiter thread of the returned futures, started by the first future
+  FutureWaiter *_Nobind_future_waiter = nullptr;
   napi_async_cleanup_hook_handle _Nobind_environment_cleanup_hook;
+  // Per-environment table of ReturnInterned strings
+  InternedStrings *_Nobind_interned_strings = nullptr;
+  // Per-environment cache of fixed property keys
+  PropertyKeys *_Nobind_property_keys = nullptr;
   // Per-environment constructors for all proxied types
   std::vector<Napi::FunctionReference> _Nobind_cons;
 
@@ -52,13 +78,14 @@ template <typename CLASS> class NoObjectWrap : public Napi::ObjectWrap<NoObjectW
   template <typename T, const ReturnAttribute &RETATTR> friend class Typemap::ToJS;
 
   // Async worker for async class methods, the wrapper is a private method below
-  template <const ReturnAttribute &RETATTR, typename BASE, auto FUNC, typename RETURN, typename... ARGS>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, auto FUNC, typename RETURN,
+            typename... ARGS>
   class MethodWrapperTasklet : public Napi::AsyncWorker {
     Napi::Env env_;
     Napi::Promise::Deferred deferred_;
     std::unique_ptr<ToJS_t<RETURN, RETATTR>> output;
     // FromJS wrappers also contain persistent references to their underlying JS values
-    std::tuple<FromJS_t<ARGS>...> args_;
+    FromJSArgs_t<ARGATTR, ARGS...> args_;
 #ifndef NOBIND_NO_ASYNC_LOCKING
     // This is the This typemap, used only for locking
     // (Node-API sets the C++ this pointer for us)
@@ -69,13 +96,17 @@ template <typename CLASS> class NoObjectWrap : public Napi::ObjectWrap<NoObjectW
     // This is the This wrapper
     NoObjectWrap<CLASS> *wrapper_;
     BASE *self_;
+    std::optional<std::string> error_;
+    AsyncLimiterSlot slot_;
+    AsyncCancellation cancellation_;
+    AsyncDispatcherSlot priority_;
 
   public:
     MethodWrapperTasklet(Napi::Env env, Napi::Promise::Deferred deferred, CLASS *self, NoObjectWrap<CLASS> *wrapper,
 #ifndef NOBIND_NO_ASYNC_LOCKING
                          FromJS_t<CLASS> &&this_tm,
 #endif
-                         std::tuple<FromJS_t<ARGS>...> &&args)
+                         FromJSArgs_t<ARGATTR, ARGS...> &&args)
         : AsyncWorker(env, "nobind_AsyncWorker"), env_(env), deferred_(deferred), output(), args_(std::move(args)),
 #ifndef NOBIND_NO_ASYNC_LOCKING
           this_tm_(std::move(this_tm)),
@@ -86,39 +117,72 @@ template <typename CLASS> class NoObjectWrap : public Napi::ObjectWrap<NoObjectW
     template <std::size_t... I> void ExecuteImpl(std::index_sequence<I...>) {
 #ifndef NOBIND_NO_ASYNC_LOCKING
       FromJSLockGuard<CLASS> this_lock_guard{this_tm_};
-      [[maybe_unused]] std::tuple<FromJSLockGuard<ARGS>...> lock_guards{std::get<I>(args_)...};
+      [[maybe_unused]] FromJSArgsLockGuards_t<ARGATTR, ARGS...> lock_guards{std::get<I>(args_)...};
 #endif
+      [[maybe_unused]] AdaptiveTimer<RETATTR, FUNC> timer;
 
       try {
         if constexpr (std::is_void_v<RETURN>) {
           // Convert and call
-          (self_->*FUNC)(std::get<I>(args_).Get()...);
+          (self_->*FUNC)(FromJSArgGet<I, ARGATTR, ARGS...>(args_)...);
         } else {
           // Convert and call
-          RETURN result = (self_->*FUNC)(std::get<I>(args_).Get()...);
+          RETURN result = (self_->*FUNC)(FromJSArgGet<I, ARGATTR, ARGS...>(args_)...);
           // Call the ToJS constructor
           output = std::make_unique<ToJS_t<RETURN, RETATTR>>(env_, result);
         }
       } catch (const std::exception &e) {
-        SetError(e.what());
+        error_ = e.what();
+        SetError(*error_);
       }
     }
 
     virtual void Execute() override { ExecuteImpl(std::index_sequence_for<ARGS...>{}); }
 
+    // ReturnLimit, the slot is released when the tasklet is destroyed
+    void Hold(AsyncLimiterSlot &&slot) { slot_ = std::move(slot); }
+
+    // ReturnCancellable, subscribe to the AbortSignal, false if it has already been aborted
+    bool Cancellable(const Napi::Value &signal) {
+      if (!cancellation_.Attach(signal, this, deferred_))
+        return false;
+      BindCancellation(args_, cancellation_.State(), std::index_sequence_for<ARGS...>{});
+      return true;
+    }
+
+    // ReturnPriority, the dispatcher queues the tasklet when it has a free slot
+    void Prioritize() { GetAsyncDispatcher(env_).Submit(this, priority_, cancellation_.State(), RETATTR.Lane()); }
+
+    // ReturnAdaptive, run on the main thread without being queued
+    void RunInline() {
+      Execute();
+      if (!error_.has_value())
+        OnOK();
+      else
+        OnError(Napi::Error::New(env_, *error_));
+    }
+
     virtual void OnOK() override {
+      // The Promise has already been rejected
+      if (cancellation_.Aborted())
+        return;
       if constexpr (std::is_void_v<RETURN>) {
-        deferred_.Resolve(env_.Undefined());
+        deferred_.Resolve(
+            ToJSResults<ARGATTR, false, ARGS...>(env_, env_.Undefined(), args_, std::index_sequence_for<ARGS...>{}));
       } else {
         try {
-          deferred_.Resolve(wrapper_->SetupNested<RETATTR>(output->Get()));
+          deferred_.Resolve(ToJSResults<ARGATTR, true, ARGS...>(env_, wrapper_->SetupNested<RETATTR>(output->Get()),
+                                                                args_, std::index_sequence_for<ARGS...>{}));
         } catch (const std::exception &e) {
           deferred_.Reject(Napi::String::New(env_, e.what()));
         }
       }
     }
 
-    virtual void OnError(const Napi::Error &e) override { deferred_.Reject(e.Value()); }
+    virtual void OnError(const Napi::Error &e) override {
+      if (!cancellation_.Aborted())
+        deferred_.Reject(e.Value());
+    }
   };
 
 public:
@@ -155,23 +219,37 @@ public:
   // The first function of the member method wrapper trio (same std::integral_constant trick)
   // This is the function that gets instantiated to create a wrapper (by getting a pointer)
   // and gets will be called by JavaScript
-  template <const ReturnAttribute &RET = ReturnDefault, auto FUNC>
+  template <const ReturnAttribute &RET = ReturnDefault, auto FUNC, const ArgumentAttribute &ARGATTR = ArgumentDefault>
   Napi::Value MethodWrapper(const Napi::CallbackInfo &info) {
-    return MethodWrapper<RET>(info, std::integral_constant<decltype(FUNC), FUNC>{});
+    return MethodWrapper<RET, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
   }
 
   // The first function of the async member trio
   // This is the function that gets instantiated to create a wrapper (by getting a pointer)
   // and gets will be called by JavaScript
-  template <const ReturnAttribute &RET = ReturnDefault, auto FUNC>
+  template <const ReturnAttribute &RET = ReturnDefault, auto FUNC, const ArgumentAttribute &ARGATTR = ArgumentDefault>
   Napi::Value MethodWrapperAsync(const Napi::CallbackInfo &info) {
-    return MethodWrapperAsync<RET>(info, std::integral_constant<decltype(FUNC), FUNC>{});
+    return MethodWrapperAsync<RET, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
+  }
+
+  // The entry point used to replay the waiting calls of ReturnLimit methods
+  template <const ReturnAttribute &RET, auto FUNC, const ArgumentAttribute &ARGATTR>
+  static Napi::Value MethodReplay(const Napi::CallbackInfo &info) {
+    return NoObjectWrap<CLASS>::Unwrap(info.This().ToObject())->template MethodWrapperAsync<RET, FUNC, ARGATTR>(info);
+  }
+
+  // The first function of the batch member trio
+  // This is the function that gets instantiated to create a wrapper (by getting a pointer)
+  // and gets will be called by JavaScript
+  template <const ReturnAttribute &RET = ReturnDefault, auto FUNC, const ArgumentAttribute &ARGATTR = ArgumentDefault>
+  Napi::Value MethodWrapperBatch(const Napi::CallbackInfo &info) {
+    return MethodWrapperBatch<RET, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
   }
 
   // Extension wrapper, 3 stages, this is the first one
-  template <const ReturnAttribute &RET = ReturnDefault, auto FUNC>
+  template <const ReturnAttribute &RET = ReturnDefault, auto FUNC, const ArgumentAttribute &ARGATTR = ArgumentDefault>
   Napi::Value ExtensionWrapper(const Napi::CallbackInfo &info) {
-    return ExtensionWrapper<RET>(info, std::integral_constant<decltype(FUNC), FUNC>{});
+    return ExtensionWrapper<RET, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{});
   }
 
   template <typename T, T CLASS::*MEMBER> Napi::Value GetterWrapper(const Napi::CallbackInfo &info) {
@@ -184,11 +262,36 @@ public:
     if constexpr (std::is_scalar_v<T>)
       // Copy scalar objects
       return ToJS<T, ReturnNested>(env, self->*MEMBER).Get();
+    else if constexpr (IsTypedArrayMember_v<T>)
+      // Return a cached TypedArray view
+      return ArrayMemberView<T, MEMBER>(env);
     else
       // Return a nested reference
       return SetupNested<ReturnNested>(ToJS<T &, ReturnNested>(env, self->*MEMBER).Get());
   }
 
+  // The TypedArray view of an array member is created on first access and it is
+  // kept in a hidden property of this object, the view references this object
+  // as its parent, a copy (ie when the runtime does not support external buffers)
+  // is never cached
+  template <typename T, T CLASS::*MEMBER> NOBIND_INLINE Napi::Value ArrayMemberView(Napi::Env env) {
+    static const size_t idx = PropertyKeys::Register();
+    static const std::string name = "__nobind_view_"s + std::to_string(idx);
+    Napi::Object wrapper = this->Value();
+    Napi::Value key = PropertyKey(env, idx, name.c_str());
+    Napi::Value view = wrapper.Get(key);
+    if (view.IsTypedArray())
+      return view;
+    view = SetupNested<ReturnNested>(ToJS<T &, ReturnNested>(env, self->*MEMBER).Get());
+    void *data;
+    if (napi_get_typedarray_info(env, view, nullptr, nullptr, &data, nullptr, nullptr) != napi_ok) {
+      throw Napi::Error::New(env, "Failed to get the TypedArray data");
+    }
+    if (data == static_cast<const void *>(&(self->*MEMBER)))
+      wrapper.DefineProperty(Napi::PropertyDescriptor::Value(key, view, napi_default));
+    return view;
+  }
+
   template <typename T, T CLASS::*MEMBER> void SetterWrapper(const Napi::CallbackInfo &info, const Napi::Value &val) {
     auto tm = FromJSValue<T>(val);
 #ifndef NOBIND_NO_ASYNC_LOCKING
@@ -213,75 +316,86 @@ public:
 
   static void
   Configure(const std::vector<std::vector<typename NoObjectWrap<CLASS>::InstanceVoidMethodCallback>> &constructors,
-            size_t idx) {
+            size_t idx, bool mirror = false, size_t offset = 0, size_t size = sizeof(CLASS)) {
     // (class_idx == 0) - first module initialization
     // (class_idx == idx) - subsequent initialization (worker_thread)
     assert(class_idx == 0 || class_idx == idx);
     class_idx = idx;
     cons = constructors;
+    mirrored = mirror;
+    mirror_offset = offset;
+    mirror_size = size;
   }
 
   static const std::string &GetName() { return name; }
 
+  // The part of the C++ object viewed by the DataView of a mirrored class
+  static bool IsMirrored() { return mirrored; }
+  static size_t MirrorOffset() { return mirror_offset; }
+  static size_t MirrorSize() { return mirror_size; }
+
 private:
   // The two remaining functions of the member method wrapper trio
   // The first (second of the three) has 4 possibles signatures:
   // - regular, const, noexcept and const noexcept
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-            RETURN (BASE::*FUNC)(ARGS...)>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...)>
   NOBIND_INLINE Napi::Value MethodWrapper(const Napi::CallbackInfo &info,
                                           std::integral_constant<RETURN (BASE::*)(ARGS...), FUNC>) {
-    return MethodWrapper<RETATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+    return MethodWrapper<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
   }
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-            RETURN (BASE::*FUNC)(ARGS...) const>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) const>
   NOBIND_INLINE Napi::Value MethodWrapper(const Napi::CallbackInfo &info,
                                           std::integral_constant<RETURN (BASE::*)(ARGS...) const, FUNC>) {
-    return MethodWrapper<RETATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+    return MethodWrapper<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
   }
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-            RETURN (BASE::*FUNC)(ARGS...) noexcept>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) noexcept>
   NOBIND_INLINE Napi::Value MethodWrapper(const Napi::CallbackInfo &info,
                                           std::integral_constant<RETURN (BASE::*)(ARGS...) noexcept, FUNC>) {
-    return MethodWrapper<RETATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+    return MethodWrapper<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
   }
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-            RETURN (BASE::*FUNC)(ARGS...) const noexcept>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) const noexcept>
   NOBIND_INLINE Napi::Value MethodWrapper(const Napi::CallbackInfo &info,
                                           std::integral_constant<RETURN (BASE::*)(ARGS...) const noexcept, FUNC>) {
-    return MethodWrapper<RETATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+    return MethodWrapper<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
   }
 
   // The last one of the trio
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, auto FUNC, typename... ARGS,
-            std::size_t... I>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN, auto FUNC,
+            typename... ARGS, std::size_t... I>
   NOBIND_INLINE Napi::Value MethodWrapper(const Napi::CallbackInfo &info, std::index_sequence<I...>) {
+    static_assert(CoroutineArgsByValue_v<RETURN, ARGS...>,
+                  "Coroutines returning a Nobind::Task must take their arguments by value");
     Napi::Env env = info.Env();
 
     size_t idx = 0;
     try {
       // Call the FromJS constructors
-      std::tuple<FromJS_t<ARGS>...> args{FromJSArgs<ARGS>(info, idx)...};
+      [[maybe_unused]] auto args = FromJSArgsAll<ARGATTR, ARGS...>(info, idx, std::index_sequence_for<ARGS...>{});
       CheckArgLength(env, idx, info.Length());
 #ifndef NOBIND_NO_ASYNC_LOCKING
       // Lock this
       FromJS_t<CLASS> this_tm = FromJSValue<CLASS>(info.This());
       FromJSLockGuard<CLASS> this_guard{this_tm};
-      [[maybe_unused]] std::tuple<FromJSLockGuard<ARGS>...> release_guards{std::get<I>(args)...};
+      [[maybe_unused]] FromJSArgsLockGuards_t<ARGATTR, ARGS...> release_guards{std::get<I>(args)...};
 #endif
 
       if constexpr (std::is_void_v<RETURN>) {
         // Convert and call
-        (static_cast<BASE *>(self)->*FUNC)(std::get<I>(args).Get()...);
-        return env.Undefined();
+        (static_cast<BASE *>(self)->*FUNC)(FromJSArgGet<I, ARGATTR, ARGS...>(args)...);
+        return ToJSResults<ARGATTR, false, ARGS...>(env, env.Undefined(), args, std::index_sequence_for<ARGS...>{});
         // FromJS objects are destroyed
       } else {
         // Convert and call
-        RETURN result = (static_cast<BASE *>(self)->*FUNC)(std::get<I>(args).Get()...);
+        RETURN result = (static_cast<BASE *>(self)->*FUNC)(FromJSArgGet<I, ARGATTR, ARGS...>(args)...);
         // Call the ToJS constructor
         auto output = ToJS_t<RETURN, RETATTR>(env, result);
         // Convert
-        return SetupNested<RETATTR>(output.Get());
+        return ToJSResults<ARGATTR, true, ARGS...>(env, SetupNested<RETATTR>(output.Get()), args,
+                                                   std::index_sequence_for<ARGS...>{});
         // FromJS/ToJS objects are destroyed
       }
     } catch (const std::exception &e) {
@@ -291,34 +405,34 @@ private:
 
   // The two remaining functions of the member async method wrapper trio (the first one with its 4 signatures)
   // (BASE == CLASS unless calling an inherited method, in this case it is the class defining it)
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-            RETURN (BASE::*FUNC)(ARGS...)>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...)>
   NOBIND_INLINE Napi::Value MethodWrapperAsync(const Napi::CallbackInfo &info,
                                                std::integral_constant<RETURN (BASE::*)(ARGS...), FUNC>) {
-    return MethodWrapperAsync<RETATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+    return MethodWrapperAsync<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
   }
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-            RETURN (BASE::*FUNC)(ARGS...) const>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) const>
   NOBIND_INLINE Napi::Value MethodWrapperAsync(const Napi::CallbackInfo &info,
                                                std::integral_constant<RETURN (BASE::*)(ARGS...) const, FUNC>) {
-    return MethodWrapperAsync<RETATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+    return MethodWrapperAsync<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
   }
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-            RETURN (BASE::*FUNC)(ARGS...) noexcept>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) noexcept>
   NOBIND_INLINE Napi::Value MethodWrapperAsync(const Napi::CallbackInfo &info,
                                                std::integral_constant<RETURN (BASE::*)(ARGS...) noexcept, FUNC>) {
-    return MethodWrapperAsync<RETATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+    return MethodWrapperAsync<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
   }
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-            RETURN (BASE::*FUNC)(ARGS...) const noexcept>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) const noexcept>
   NOBIND_INLINE Napi::Value MethodWrapperAsync(const Napi::CallbackInfo &info,
                                                std::integral_constant<RETURN (BASE::*)(ARGS...) const noexcept, FUNC>) {
-    return MethodWrapperAsync<RETATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
+    return MethodWrapperAsync<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info, std::index_sequence_for<ARGS...>{});
   }
 
   // The actual wrapper for async class methods
-  template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, auto FUNC, typename... ARGS,
-            std::size_t... I>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN, auto FUNC,
+            typename... ARGS, std::size_t... I>
   NOBIND_INLINE Napi::Value MethodWrapperAsync(const Napi::CallbackInfo &info, std::index_sequence<I...>) {
     Napi::Env env = info.Env();
 
@@ -327,26 +441,41 @@ private:
 #pragma warning(push)
 #pragma warning(disable : 6001)
 #endif
+    AsyncLimiterSlot slot;
+    if constexpr (RETATTR.isLimited()) {
+      AsyncLimiter &limiter = GetAsyncLimiter<FUNC, RETATTR>(env);
+      if (!limiter.Acquire())
+        return limiter.Wait(info);
+      slot = AsyncLimiterSlot{&limiter};
+    }
+
     Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
 
     try {
       size_t idx = 0;
-      // Alas, std::forward_as_tuple does not guarantee
-      // the evaluation order of its arguments, only *braced-init-list* lists do
-      // https://en.cppreference.com/w/cpp/language/list_initialization
-      auto tasklet = new MethodWrapperTasklet<RETATTR, BASE, FUNC, RETURN, ARGS...>(env, deferred, self, this,
+      // FromJSArgsAllDeferred guarantees the evaluation order of the FromJS constructors
+      auto tasklet = new MethodWrapperTasklet<RETATTR, ARGATTR, BASE, FUNC, RETURN, ARGS...>(
+          env, deferred, self, this,
 #ifndef NOBIND_NO_ASYNC_LOCKING
-                                                                                    FromJSValue<CLASS>(info.This()),
+          FromJSValue<CLASS>(info.This()),
 #endif
-                                                                                    {FromJSArgs<ARGS>(info, idx)...});
+          FromJSArgsAllDeferred<ARGATTR, ARGS...>(info, idx, std::index_sequence_for<ARGS...>{}));
+      tasklet->Hold(std::move(slot));
       try {
-        CheckArgLength(env, idx, info.Length());
+        // The optional AbortSignal of cancellable calls is the last argument
+        CheckArgLength(env, idx, info.Length() - (HasAbortSignal<RETATTR>(info, idx) ? 1 : 0));
+        if constexpr (RETATTR.isCancellable()) {
+          if (!tasklet->Cancellable(info[idx])) {
+            delete tasklet;
+            return deferred.Promise();
+          }
+        }
       } catch (...) {
         delete tasklet;
         std::rethrow_exception(std::current_exception());
       }
 
-      tasklet->Queue();
+      AdaptiveQueue<RETATTR, FUNC>(tasklet);
     } catch (const std::exception &e) {
       deferred.Reject(Napi::Error::New(env, e.what()).Value());
     }
@@ -356,6 +485,55 @@ private:
 #endif
   }
 
+  // The two remaining functions of the batch member method wrapper trio (the first one with its 4 signatures)
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...)>
+  NOBIND_INLINE Napi::Value MethodWrapperBatch(const Napi::CallbackInfo &info,
+                                               std::integral_constant<RETURN (BASE::*)(ARGS...), FUNC>) {
+    return MethodWrapperBatch<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info);
+  }
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) const>
+  NOBIND_INLINE Napi::Value MethodWrapperBatch(const Napi::CallbackInfo &info,
+                                               std::integral_constant<RETURN (BASE::*)(ARGS...) const, FUNC>) {
+    return MethodWrapperBatch<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info);
+  }
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) noexcept>
+  NOBIND_INLINE Napi::Value MethodWrapperBatch(const Napi::CallbackInfo &info,
+                                               std::integral_constant<RETURN (BASE::*)(ARGS...) noexcept, FUNC>) {
+    return MethodWrapperBatch<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info);
+  }
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+            typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) const noexcept>
+  NOBIND_INLINE Napi::Value MethodWrapperBatch(const Napi::CallbackInfo &info,
+                                               std::integral_constant<RETURN (BASE::*)(ARGS...) const noexcept, FUNC>) {
+    return MethodWrapperBatch<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(info);
+  }
+
+  // The actual wrapper for batch class methods, this is locked only once for all the elements
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN, auto FUNC,
+            typename... ARGS>
+  NOBIND_INLINE Napi::Value MethodWrapperBatch(const Napi::CallbackInfo &info) {
+    static_assert(!RETATTR.isNested(), "Batch methods cannot return nested objects");
+    Napi::Env env = info.Env();
+
+    try {
+#ifndef NOBIND_NO_ASYNC_LOCKING
+      // Lock this
+      FromJS_t<CLASS> this_tm = FromJSValue<CLASS>(info.This());
+      FromJSLockGuard<CLASS> this_guard{this_tm};
+#endif
+      BASE *base = static_cast<BASE *>(self);
+      return BatchCall<RETATTR, ARGATTR, RETURN, ARGS...>(
+          info,
+          [base](auto &&...args) -> RETURN { return (base->*FUNC)(std::forward<decltype(args)>(args)...); },
+          std::index_sequence_for<ARGS...>{});
+    } catch (const std::exception &e) {
+      throw Napi::Error::New(env, e.what());
+    }
+  }
+
   // The constructor wrapper implementation
   template <typename... ARGS, std::size_t... I>
   NOBIND_INLINE void ConsWrapper(const Napi::CallbackInfo &info, std::index_sequence<I...>) {
@@ -363,69 +541,85 @@ private:
 
     // Call the FromJS constructors
     size_t idx = 0;
-    std::tuple<FromJS_t<ARGS>...> args{FromJSArgs<ARGS>(info, idx)...};
+    [[maybe_unused]] auto args = FromJSArgsAll<ArgumentDefault, ARGS...>(info, idx, std::index_sequence_for<ARGS...>{});
     CheckArgLength(env, idx, info.Length());
 #ifndef NOBIND_NO_ASYNC_LOCKING
-    [[maybe_unused]] std::tuple<FromJSLockGuard<ARGS>...> release_guards{std::get<I>(args)...};
+    [[maybe_unused]] FromJSArgsLockGuards_t<ArgumentDefault, ARGS...> release_guards{std::get<I>(args)...};
 #endif
 
     // Convert and call
-    self = new CLASS(std::get<I>(args).Get()...);
+    self = new CLASS(FromJSArgGet<I, ArgumentDefault, ARGS...>(args)...);
+    if (mirrored) {
+      try {
+        AttachMirror(env, info.This().ToObject());
+      } catch (...) {
+        if constexpr (std::is_destructible_v<CLASS>)
+          delete self;
+        self = nullptr;
+        throw;
+      }
+    }
   }
 
   // The extension wrapper, it adds an additional first argument by converting info.This()
   // Three stages, second stage, This() is CLASS &
-  template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(CLASS &, ARGS...)>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+            RETURN (*FUNC)(CLASS &, ARGS...)>
   NOBIND_INLINE Napi::Value ExtensionWrapper(const Napi::CallbackInfo &info,
                                              std::integral_constant<RETURN (*)(CLASS &, ARGS...), FUNC>) {
-    return ExtensionWrapper<RETATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{},
-                                     std::index_sequence_for<ARGS...>{});
+    return ExtensionWrapper<RETATTR, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{},
+                                              std::index_sequence_for<ARGS...>{});
   }
   // Second stage, This() is const CLASS &
-  template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(const CLASS &, ARGS...)>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+            RETURN (*FUNC)(const CLASS &, ARGS...)>
   NOBIND_INLINE Napi::Value ExtensionWrapper(const Napi::CallbackInfo &info,
                                              std::integral_constant<RETURN (*)(const CLASS &, ARGS...), FUNC>) {
-    return ExtensionWrapper<RETATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{},
-                                     std::index_sequence_for<ARGS...>{});
+    return ExtensionWrapper<RETATTR, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{},
+                                              std::index_sequence_for<ARGS...>{});
   }
   // Second stage, This() is Napi::Value
-  template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(Napi::Value, ARGS...)>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+            RETURN (*FUNC)(Napi::Value, ARGS...)>
   NOBIND_INLINE Napi::Value ExtensionWrapper(const Napi::CallbackInfo &info,
                                              std::integral_constant<RETURN (*)(Napi::Value, ARGS...), FUNC>) {
-    return ExtensionWrapper<RETATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{},
-                                     std::index_sequence_for<ARGS...>{});
+    return ExtensionWrapper<RETATTR, ARGATTR>(info, std::integral_constant<decltype(FUNC), FUNC>{},
+                                              std::index_sequence_for<ARGS...>{});
   }
   // Third stage
-  template <const ReturnAttribute &RETATTR, typename SELF, typename RETURN, typename... ARGS,
-            RETURN (*FUNC)(SELF, ARGS...), std::size_t... I>
+  template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename SELF, typename RETURN,
+            typename... ARGS, RETURN (*FUNC)(SELF, ARGS...), std::size_t... I>
   NOBIND_INLINE Napi::Value ExtensionWrapper(const Napi::CallbackInfo &info,
                                              std::integral_constant<RETURN (*)(SELF, ARGS...), FUNC>,
                                              std::index_sequence<I...>) {
+    static_assert(CoroutineArgsByValue_v<RETURN, ARGS...>,
+                  "Coroutines returning a Nobind::Task must take their arguments by value");
     Napi::Env env = info.Env();
 
     try {
       auto this_obj = FromJSValue<SELF>(info.This());
       // Call the FromJS constructors
       size_t idx = 0;
-      std::tuple<FromJS_t<ARGS>...> args{FromJSArgs<ARGS>(info, idx)...};
+      [[maybe_unused]] auto args = FromJSArgsAll<ARGATTR, ARGS...>(info, idx, std::index_sequence_for<ARGS...>{});
       CheckArgLength(env, idx, info.Length());
 #ifndef NOBIND_NO_ASYNC_LOCKING
       FromJSLockGuard<SELF> this_guard{this_obj};
-      [[maybe_unused]] std::tuple<FromJSLockGuard<ARGS>...> release_guards{std::get<I>(args)...};
+      [[maybe_unused]] FromJSArgsLockGuards_t<ARGATTR, ARGS...> release_guards{std::get<I>(args)...};
 #endif
 
       if constexpr (std::is_void_v<RETURN>) {
         // Convert and call
-        FUNC(this_obj.Get(), std::get<I>(args).Get()...);
-        return env.Undefined();
+        FUNC(this_obj.Get(), FromJSArgGet<I, ARGATTR, ARGS...>(args)...);
+        return ToJSResults<ARGATTR, false, ARGS...>(env, env.Undefined(), args, std::index_sequence_for<ARGS...>{});
         // FromJS objects are destroyed
       } else {
         // Convert and call
-        RETURN result = FUNC(this_obj.Get(), std::get<I>(args).Get()...);
+        RETURN result = FUNC(this_obj.Get(), FromJSArgGet<I, ARGATTR, ARGS...>(args)...);
         // Call the ToJS constructor
         auto output = ToJS_t<RETURN, RETATTR>(env, result);
         // Convert
-        return SetupNested<RETATTR>(output.Get());
+        return ToJSResults<ARGATTR, true, ARGS...>(env, SetupNested<RETATTR>(output.Get()), args,
+                                                   std::index_sequence_for<ARGS...>{});
         // FromJS/ToJS objects are destroyed
       }
     } catch (const std::exception &e) {
@@ -440,12 +634,29 @@ private:
         // We simply attach the parent (this) as a hidden property in the nested object
         // This way the parent cannot be GCed until the nested objects is GCed
         returned.ToObject().DefineProperty(
-            Napi::PropertyDescriptor::Value(NOBIND_PARENT_PROP, this->Value(), napi_default));
+            Napi::PropertyDescriptor::Value(PropertyKey<key_parent>(returned.Env()), this->Value(), napi_default));
       }
     }
     return returned;
   }
 
+  // Attach a DataView of the C++ object to the JS object of a mirrored class,
+  // the external ArrayBuffer does not own the C++ object, so it can be detached
+  // or transferred from JS without freeing it
+  // (a class inheriting from a mirrored class views only its mirrored base)
+  NOBIND_INLINE void AttachMirror(Napi::Env env, Napi::Object object) {
+    napi_value buffer, view;
+    void *data = reinterpret_cast<unsigned char *>(self) + mirror_offset;
+    if (napi_create_external_arraybuffer(env, data, mirror_size, nullptr, nullptr, &buffer) != napi_ok) {
+      throw Napi::Error::New(env, "Mirrored class "s + name + " requires external ArrayBuffers"s);
+    }
+    if (napi_create_dataview(env, mirror_size, buffer, 0, &view) != napi_ok) {
+      throw Napi::Error::New(env, "Failed to create a DataView");
+    }
+    object.DefineProperty(
+        Napi::PropertyDescriptor::Value(PropertyKey<key_mirror>(env), Napi::Value(env, view), napi_default));
+  }
+
   // Register a custom finalizer
   NOBIND_INLINE void SetFinalizer(Finalizer f) {
     NOBIND_ASSERT(!finalizer_);
@@ -458,6 +669,10 @@ private:
   static std::string name;
   // The class constructors
   static std::vector<std::vector<typename NoObjectWrap<CLASS>::InstanceVoidMethodCallback>> cons;
+  // Are the number fields mirrored in JS
+  static bool mirrored;
+  // The offset and the size of the mirrored part of the C++ object
+  static size_t mirror_offset, mirror_size;
   // The underlying C++ object
   CLASS *self;
   // Should we destroy it in the destructor
@@ -474,6 +689,9 @@ template <typename CLASS> size_t NoObjectWrap<CLASS>::class_idx = 0;
 template <typename CLASS> std::string NoObjectWrap<CLASS>::name = NOBIND_NAME_NOT_INITIALIZED;
 template <typename CLASS>
 std::vector<std::vector<typename NoObjectWrap<CLASS>::InstanceVoidMethodCallback>> NoObjectWrap<CLASS>::cons;
+template <typename CLASS> bool NoObjectWrap<CLASS>::mirrored = false;
+template <typename CLASS> size_t NoObjectWrap<CLASS>::mirror_offset = 0;
+template <typename CLASS> size_t NoObjectWrap<CLASS>::mirror_size = 0;
 
 #ifdef NODE_API_EXPERIMENTAL_HAS_POST_FINALIZER
 template <typename CLASS> NoObjectWrap<CLASS>::~NoObjectWrap() { assert(self == nullptr); }
@@ -532,6 +750,8 @@ NoObjectWrap<CLASS>::NoObjectWrap(const Napi::CallbackInfo &info)
     owned = info[1].ToBoolean().Value();
     self = info[0].As<Napi::External<CLASS>>().Data();
     NOBIND_VERBOSE_TYPE(OBJECT, CLASS, self, "create wrapper for C++ object [owned=%s]\n", owned ? "true" : "false");
+    if (mirrored)
+      AttachMirror(env, info.This().ToObject());
     return;
   }
   // From JS
@@ -706,25 +926,71 @@ template <typename CLASS, typename BASE, typename... INTERFACES> class ClassDefi
   std::vector<Napi::ClassPropertyDescriptor<NoObjectWrap<CLASS>>> properties;
   std::vector<std::vector<typename NoObjectWrap<CLASS>::InstanceVoidMethodCallback>> constructors;
   size_t class_idx_;
+  bool mirrored_;
+  std::vector<MirroredField> mirrored_fields_;
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
   std::string class_typescript_types_, &global_typescript_types_;
 #endif
 
+  // ReturnAdaptive methods are listed as Class.method (methods named by symbols are not listed)
+  template <auto MEMBER, typename NAME> void AdaptiveBinding(NAME name) {
+    if constexpr (!std::is_same_v<NAME, Napi::Symbol>) {
+      env_.GetInstanceData<BaseEnvInstanceData>()->_Nobind_adaptive_bindings.emplace_back(
+          std::string{name_} + "." + std::string{name}, &Adaptive<MEMBER>());
+    }
+  }
+
+  // ReturnLimit methods are listed as Class.method
+  template <auto MEMBER, const ReturnAttribute &RET, typename NAME>
+  void LimitedBinding(NAME name, Napi::Function replay) {
+    std::string method;
+    if constexpr (std::is_same_v<NAME, Napi::Symbol>) {
+      method = "[symbol]";
+    } else {
+      method = name;
+    }
+    env_.GetInstanceData<BaseEnvInstanceData>()->_Nobind_async_limiters.template Add<MEMBER, RET>(
+        env_, std::string{name_} + "." + method, replay);
+  }
+
+  // ReturnMemoized static methods are listed as Class.method
+  template <auto *MEMBER, typename NAME> void MemoizedBinding(NAME name) {
+    if constexpr (!std::is_same_v<NAME, Napi::Symbol>) {
+      env_.GetInstanceData<BaseEnvInstanceData>()->_Nobind_memoized_bindings.emplace_back(
+          std::string{name_} + "." + std::string{name}, &MemoizedFunction<MEMBER>());
+    }
+  }
+
 public:
   // Instance class method
-  template <auto MEMBER, const ReturnAttribute &RET = ReturnDefault, typename NAME = const char *>
+  template <auto MEMBER, const ReturnAttribute &RET = ReturnDefault, const ArgumentAttribute &ARGATTR = ArgumentDefault,
+            typename NAME = const char *>
   std::enable_if_t<std::is_member_function_pointer_v<decltype(MEMBER)>, ClassDefinition &> def(NAME name) {
+    static_assert(!RET.isParallel(), "Parallel batch calls are supported only for functions and static methods");
+    static_assert(!RET.isMemoized(), "Memoization is supported only for functions and static methods");
     typename NoObjectWrap<CLASS>::InstanceMethodCallback wrapper;
 
     if constexpr (RET.isAsync()) {
-      wrapper = &NoObjectWrap<CLASS>::template MethodWrapperAsync<RET, MEMBER>;
+      wrapper = &NoObjectWrap<CLASS>::template MethodWrapperAsync<RET, MEMBER, ARGATTR>;
+    } else if constexpr (RET.isBatch()) {
+      wrapper = &NoObjectWrap<CLASS>::template MethodWrapperBatch<RET, MEMBER, ARGATTR>;
     } else {
-      wrapper = &NoObjectWrap<CLASS>::template MethodWrapper<RET, MEMBER>;
+      wrapper = &NoObjectWrap<CLASS>::template MethodWrapper<RET, MEMBER, ARGATTR>;
     }
     properties.emplace_back(NoObjectWrap<CLASS>::InstanceMethod(name, wrapper));
+    if constexpr (RET.isAdaptive()) {
+      AdaptiveBinding<MEMBER>(name);
+    }
+    if constexpr (RET.isLimited()) {
+      LimitedBinding<MEMBER, RET>(name, Napi::Function::New(
+                                            env_, &NoObjectWrap<CLASS>::template MethodReplay<RET, MEMBER, ARGATTR>));
+    }
+    if constexpr (RET.isPrioritized()) {
+      GetAsyncDispatcher(env_).Use();
+    }
 
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
-    std::string typescript_types = MethodSignature<RET, MEMBER>(name, "  ");
+    std::string typescript_types = MethodSignature<RET, MEMBER, ARGATTR>(name, "  ");
     class_typescript_types_ += typescript_types;
 #endif
 
@@ -732,28 +998,42 @@ public:
   }
 
   // Instance class method / sync+async shortcut
-  template <auto MEMBER, const ReturnAttribute &RET = ReturnDefault, typename NAME = const char *>
+  template <auto MEMBER, const ReturnAttribute &RET = ReturnDefault, const ArgumentAttribute &ARGATTR = ArgumentDefault,
+            typename NAME = const char *>
   std::enable_if_t<std::is_member_function_pointer_v<decltype(MEMBER)>, ClassDefinition &> def(NAME name_sync,
                                                                                                NAME name_async) {
     static_assert(!RET.isAsync(), "Do not specify async with the duplex definition");
-    def<MEMBER, RET>(name_sync);
-    def<MEMBER, RetWithAsync<RET>>(name_async);
+    def<MEMBER, RET, ARGATTR>(name_sync);
+    def<MEMBER, RetWithAsync<RET>, ARGATTR>(name_async);
     return *this;
   }
 
   // Instance class getter/setter
   template <auto CLASS::*MEMBER, const PropertyAttribute &PROP = ReadWrite, typename NAME = const char *>
   std::enable_if_t<std::is_member_object_pointer_v<decltype(MEMBER)>, ClassDefinition &> def(NAME name) {
+    using T = MemberPointerType_t<decltype(MEMBER)>;
+    // Array members are views that cannot be reassigned (but their elements can)
+    constexpr const PropertyAttribute &prop = IsTypedArrayMember_v<T> ? ReadOnly : PROP;
     typename NoObjectWrap<CLASS>::InstanceGetterCallback getter =
-        &NoObjectWrap<CLASS>::template GetterWrapper<decltype(getMemberPointerType(MEMBER)), MEMBER>;
+        &NoObjectWrap<CLASS>::template GetterWrapper<T, MEMBER>;
     typename NoObjectWrap<CLASS>::InstanceSetterCallback setter = nullptr;
-    if constexpr (!PROP.isReadOnly()) {
-      setter = &NoObjectWrap<CLASS>::template SetterWrapper<decltype(getMemberPointerType(MEMBER)), MEMBER>;
+    if constexpr (!prop.isReadOnly()) {
+      setter = &NoObjectWrap<CLASS>::template SetterWrapper<T, MEMBER>;
+    }
+    if constexpr (std::is_trivially_copyable_v<CLASS> && IsMirroredField_v<std::remove_cv_t<T>> &&
+                  !std::is_same_v<NAME, Napi::Symbol>) {
+      // The offset of the field, in case the class is mirrored
+      alignas(CLASS) unsigned char storage[sizeof(CLASS)];
+      CLASS *object = reinterpret_cast<CLASS *>(storage);
+      const unsigned char *field = reinterpret_cast<const unsigned char *>(&(object->*MEMBER));
+      mirrored_fields_.push_back({std::string{name}, static_cast<size_t>(field - storage),
+                                  MirrorDataViewType<std::remove_cv_t<T>>(), std::is_same_v<std::remove_cv_t<T>, bool>,
+                                  prop.isReadOnly(), properties.size()});
     }
     properties.emplace_back(NoObjectWrap<CLASS>::InstanceAccessor(name, getter, setter));
 
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
-    std::string typescript_types = PropertySignature<PROP, decltype(getMemberPointerType(MEMBER))>(name, "  ");
+    std::string typescript_types = PropertySignature<prop, T>(name, "  ");
     class_typescript_types_ += typescript_types;
 #endif
 
@@ -761,18 +1041,35 @@ public:
   }
 
   // Static class method
-  template <auto *MEMBER, const ReturnAttribute &RET = ReturnDefault, typename NAME = const char *>
+  template <auto *MEMBER, const ReturnAttribute &RET = ReturnDefault,
+            const ArgumentAttribute &ARGATTR = ArgumentDefault, typename NAME = const char *>
   std::enable_if_t<std::is_function_v<std::remove_pointer_t<decltype(MEMBER)>>, ClassDefinition &> def(NAME name) {
     Napi::Function::Callback wrapper;
-    if constexpr (RET.isAsync()) {
-      wrapper = &FunctionWrapperAsync<RET, MEMBER>;
+    if constexpr (RET.isParallel()) {
+      wrapper = &FunctionWrapperParallel<RET, MEMBER, ARGATTR>;
+    } else if constexpr (RET.isAsync()) {
+      wrapper = &FunctionWrapperAsync<RET, MEMBER, ARGATTR>;
+    } else if constexpr (RET.isBatch()) {
+      wrapper = &FunctionWrapperBatch<RET, MEMBER, ARGATTR>;
     } else {
-      wrapper = &FunctionWrapper<RET, MEMBER>;
+      wrapper = &FunctionWrapper<RET, MEMBER, ARGATTR>;
     }
     properties.emplace_back(NoObjectWrap<CLASS>::StaticMethod(name, wrapper));
+    if constexpr (RET.isAdaptive()) {
+      AdaptiveBinding<MEMBER>(name);
+    }
+    if constexpr (RET.isMemoized()) {
+      MemoizedBinding<MEMBER>(name);
+    }
+    if constexpr (RET.isLimited()) {
+      LimitedBinding<MEMBER, RET>(name, Napi::Function::New(env_, wrapper));
+    }
+    if constexpr (RET.isPrioritized()) {
+      GetAsyncDispatcher(env_).Use();
+    }
 
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
-    std::string typescript_types = FunctionSignature<RET, MEMBER>(name, "  static ");
+    std::string typescript_types = FunctionSignature<RET, MEMBER, ARGATTR>(name, "  static ");
     class_typescript_types_ += typescript_types;
 #endif
 
@@ -780,12 +1077,13 @@ public:
   }
 
   // Static class method / sync+async shortcut
-  template <auto *MEMBER, const ReturnAttribute &RET = ReturnDefault, typename NAME = const char *>
+  template <auto *MEMBER, const ReturnAttribute &RET = ReturnDefault,
+            const ArgumentAttribute &ARGATTR = ArgumentDefault, typename NAME = const char *>
   std::enable_if_t<std::is_function_v<std::remove_pointer_t<decltype(MEMBER)>>, ClassDefinition &>
   def(NAME name_sync, NAME name_async) {
     static_assert(!RET.isAsync(), "Do not specify async with the duplex definition");
-    def<MEMBER, RET>(name_sync);
-    def<MEMBER, RetWithAsync<RET>>(name_async);
+    def<MEMBER, RET, ARGATTR>(name_sync);
+    def<MEMBER, RetWithAsync<RET>, ARGATTR>(name_async);
     return *this;
   }
 
@@ -809,28 +1107,38 @@ public:
   }
 
   // Class extension
-  template <auto *FUNC, const ReturnAttribute &RET = ReturnDefault, typename NAME = const char *>
+  template <auto *FUNC, const ReturnAttribute &RET = ReturnDefault, const ArgumentAttribute &ARGATTR = ArgumentDefault,
+            typename NAME = const char *>
   ClassDefinition &ext(NAME name) {
     typename NoObjectWrap<CLASS>::InstanceMethodCallback wrapper;
     static_assert(!RET.isAsync(), "Asynchronous class extensions are not supported, use a global function helper");
 
-    wrapper = &NoObjectWrap<CLASS>::template ExtensionWrapper<RET, FUNC>;
+    wrapper = &NoObjectWrap<CLASS>::template ExtensionWrapper<RET, FUNC, ARGATTR>;
     properties.emplace_back(NoObjectWrap<CLASS>::InstanceMethod(name, wrapper));
 
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
-    std::string typescript_types = ExtensionSignature<RET, FUNC>(name, "  ");
+    std::string typescript_types = ExtensionSignature<RET, FUNC, ARGATTR>(name, "  ");
     class_typescript_types_ += typescript_types;
 #endif
 
     return *this;
   }
 
+  // Mirror the number fields in JS, the class must be trivially copyable
+  ClassDefinition &mirror() {
+    static_assert(std::is_trivially_copyable_v<CLASS>, "Only trivially copyable classes can be mirrored");
+    mirrored_ = true;
+    return *this;
+  }
+
   template <typename... ARGS> ClassDefinition &cons() {
     typename NoObjectWrap<CLASS>::InstanceVoidMethodCallback wrapper =
         &NoObjectWrap<CLASS>::template ConsWrapper<ARGS...>;
-    if (constructors.size() <= sizeof...(ARGS) + 1)
-      constructors.resize(sizeof...(ARGS) + 1);
-    constructors[sizeof...(ARGS)].push_back(wrapper);
+    // Constructors are indexed by the number of JS arguments
+    constexpr size_t inputs = FromJSArgsInputs<ArgumentDefault, ARGS...>;
+    if (constructors.size() <= inputs + 1)
+      constructors.resize(inputs + 1);
+    constructors[inputs].push_back(wrapper);
 
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
     std::string typescript_types = "  " + ConstructorSignature<ARGS...>();
@@ -858,7 +1166,8 @@ public:
                            std::string &global_typescript_types
 #endif
                            )
-      : name_(name), env_(env), exports_(exports), properties(), constructors(), class_idx_(class_idx)
+      : name_(name), env_(env), exports_(exports), properties(), constructors(), class_idx_(class_idx),
+        mirrored_(false), mirrored_fields_()
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
         ,
         class_typescript_types_(""), global_typescript_types_(global_typescript_types)
@@ -868,9 +1177,35 @@ public:
   }
 
   ~ClassDefinition() noexcept(false) {
+    if (mirrored_) {
+      // The native accessors of the mirrored fields are replaced by JS accessors
+      for (auto field = mirrored_fields_.rbegin(); field != mirrored_fields_.rend(); field++)
+        properties.erase(properties.begin() + field->idx);
+    }
     Napi::Function ctor = NoObjectWrap<CLASS>::GetClass(env_, name_, properties);
     auto instance = env_.GetInstanceData<BaseEnvInstanceData>();
-    NoObjectWrap<CLASS>::Configure(constructors, class_idx_);
+    bool mirror = mirrored_;
+    size_t mirror_offset = 0, mirror_size = sizeof(CLASS);
+    if constexpr (!std::is_void_v<BASE>) {
+      if (NoObjectWrap<BASE>::IsMirrored()) {
+        // The inherited JS accessors read the DataView at the offsets of the mirrored base
+        alignas(CLASS) unsigned char storage[sizeof(CLASS)];
+        CLASS *object = reinterpret_cast<CLASS *>(storage);
+        unsigned char *base = reinterpret_cast<unsigned char *>(static_cast<BASE *>(object));
+        size_t base_offset = static_cast<size_t>(base - storage) + NoObjectWrap<BASE>::MirrorOffset();
+        if (!mirror) {
+          mirror = true;
+          mirror_offset = base_offset;
+          mirror_size = NoObjectWrap<BASE>::MirrorSize();
+        } else if (base_offset != 0) {
+          throw Napi::Error::New(env_, "Mirrored class "s + name_ + " does not start with its mirrored base class "s +
+                                           NoObjectWrap<BASE>::GetName());
+        }
+      }
+    }
+    NoObjectWrap<CLASS>::Configure(constructors, class_idx_, mirror, mirror_offset, mirror_size);
+    if (mirrored_)
+      DefineMirroredFields(env_, ctor, mirrored_fields_);
     instance->_Nobind_cons.emplace(instance->_Nobind_cons.begin() + class_idx_, Napi::Persistent(ctor));
     exports_.Set(name_, ctor);
 
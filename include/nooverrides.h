@@ -1,10 +1,30 @@
 #pragma once
 #include <noattributes.h>
+#include <nodebug.h>
 #include <nonapi.h>
 #include <type_traits>
 
 namespace Nobind {
 
+// A view over several consecutive JS arguments, it is passed to the
+// constructor of the typemaps that consume more than one JS value (Inputs > 1)
+class JSArgs {
+  const Napi::CallbackInfo &info_;
+  size_t first_;
+  size_t length_;
+
+public:
+  NOBIND_INLINE JSArgs(const Napi::CallbackInfo &info, size_t first, size_t length)
+      : info_(info), first_(first), length_(length) {}
+  NOBIND_INLINE Napi::Value operator[](size_t i) const { return info_[first_ + i]; }
+  NOBIND_INLINE size_t Length() const { return length_; }
+  NOBIND_INLINE Napi::Env Env() const { return info_.Env(); }
+};
+
+// The tag of the deferred constructors of the typemaps, the async calls construct
+// the typemaps that support it with (const Napi::Value &, FromJSDeferred)
+struct FromJSDeferred {};
+
 namespace Typemap {
 /**
  * Typemap::FromJS rules
@@ -16,6 +36,11 @@ namespace Typemap {
  * - When throwing a JS Error, throw in the constructor (throw where the Napi::Value is)
  *   (throwing an std::exception is allowed everywhere)
  * - When locking against reentrancy, lock in Lock(), unlock in Unlock()
+ * - Inputs is the number of JS arguments consumed (1 by default), the constructor
+ *   of a typemap that consumes more than one JS argument receives a JSArgs
+ * - The optional (const Napi::Value &, FromJSDeferred) constructor is used by the async
+ *   calls, it should only capture the raw data (the string bytes, a copy of a TypedArray...)
+ *   and leave the expensive construction of the C++ value to Get() on the worker thread
  */
 template <typename T> class FromJS;
 
@@ -29,6 +54,54 @@ template <typename T> class FromJS;
  *   (throwing an std::exception is allowed everywhere)
  */
 template <typename T, const ReturnAttribute &RETATTR = ReturnDefault> class ToJS;
+
+/**
+ * Typemap::FromJSMulti rules
+ * - Same rules as Typemap::FromJS
+ * - The typemap is specialized on a sequence of consecutive C++ argument types,
+ *   it consumes JS arguments once and produces all of them
+ * - Get<N>() returns the Nth C++ argument of the sequence
+ */
+template <typename... T> class FromJSMulti {
+  FromJSMulti() = delete;
+};
+
+/**
+ * Typemap::ToJSMulti rules
+ * - Same rules as Typemap::ToJS
+ * - The typemap is specialized on a sequence of consecutive C++ output arguments,
+ *   the first one is marked by ArgOutput<>
+ * - The constructor receives the Napi::Env before the call
+ * - Get<N>() returns the Nth C++ argument of the sequence (usually a pointer to a member)
+ * - Get() returns the JS value after the call
+ */
+template <typename... T> class ToJSMulti {
+  ToJSMulti() = delete;
+};
+
+/**
+ * Typemap::FromJSCoerce, Typemap::FromJSUnchecked, Typemap::FromJSLatin1
+ * and Typemap::FromJSStructOfArrays rules
+ * - Same rules as Typemap::FromJS
+ * - They are optional alternatives to Typemap::FromJS selected by ArgCoerce<>, ArgUnchecked<>, ArgLatin1<>
+ *   and ArgStructOfArrays<>
+ * - FromJSCoerce should accept any value that can be converted following the JS semantics
+ * - FromJSUnchecked should use the minimum number of Node-API calls and rely on their status
+ * - FromJSLatin1 should produce a string encoded in Latin-1
+ * - FromJSStructOfArrays should produce a container of structs from an object of arrays
+ */
+template <typename T> class FromJSCoerce {
+  FromJSCoerce() = delete;
+};
+template <typename T> class FromJSUnchecked {
+  FromJSUnchecked() = delete;
+};
+template <typename T> class FromJSLatin1 {
+  FromJSLatin1() = delete;
+};
+template <typename T> class FromJSStructOfArrays {
+  FromJSStructOfArrays() = delete;
+};
 } // namespace Typemap
 
 #ifndef NOBIND_NO_TYPESCRIPT_GENERATOR
@@ -45,6 +118,12 @@ template <typename T> class FromJS {
 template <typename T, const ReturnAttribute &RETATTR = ReturnDefault> class ToJS {
   ToJS() = delete;
 };
+template <typename... T> class FromJSMulti {
+  FromJSMulti() = delete;
+};
+template <typename... T> class ToJSMulti {
+  ToJSMulti() = delete;
+};
 
 } // namespace TypemapOverrides
 } // namespace Nobind
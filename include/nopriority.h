@@ -0,0 +1,180 @@
+#pragma once
+#include <nonapi.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+
+#include <noattributes.h>
+#include <nocancel.h>
+
+// The number of prioritized calls in the thread pool at the same time,
+// 0 uses the size of the libuv thread pool
+#ifndef NOBIND_PRIORITY_SLOTS
+#define NOBIND_PRIORITY_SLOTS 0
+#endif
+
+// A waiting call moves up one lane for every NOBIND_PRIORITY_AGING milliseconds
+#ifndef NOBIND_PRIORITY_AGING
+#define NOBIND_PRIORITY_AGING 100
+#endif
+
+#ifndef NOBIND_PRIORITY_PROP
+#define NOBIND_PRIORITY_PROP "__lanes"
+#endif
+
+namespace Nobind {
+
+struct BaseEnvInstanceData;
+class AsyncDispatcher;
+
+// Priority lanes
+//
+// The libuv thread pool is a single FIFO queue. The tasklets of the ReturnPriority
+// bindings are not queued directly, they wait in the per-environment dispatcher,
+// in one FIFO queue per lane. The dispatcher never has more tasklets in the thread
+// pool than it has threads, so a new call does not wait behind the calls already
+// queued there, and when a tasklet is destroyed, its slot goes to the first call
+// of the highest lane. The waiting calls age to prevent starvation.
+
+// Held by a prioritized tasklet, frees its slot when it is destroyed
+class AsyncDispatcherSlot {
+  friend class AsyncDispatcher;
+  AsyncDispatcher *dispatcher_;
+
+public:
+  AsyncDispatcherSlot() : dispatcher_(nullptr) {}
+  AsyncDispatcherSlot(const AsyncDispatcherSlot &) = delete;
+  ~AsyncDispatcherSlot();
+};
+
+class AsyncDispatcher {
+  struct Waiting {
+    Napi::AsyncWorker *worker;
+    AsyncDispatcherSlot *slot;
+    // Only for ReturnCancellable, a cancelled call is destroyed without being queued
+    std::shared_ptr<CancellationState> cancellation;
+    std::chrono::steady_clock::time_point since;
+  };
+  struct Lane {
+    std::deque<Waiting> waiting;
+    // promoted counts the calls started ahead of a higher lane because of their age
+    uint64_t dispatched = 0, promoted = 0, cancelled = 0;
+  };
+  static constexpr const char *names[ReturnAttribute::Lanes] = {"high", "normal", "background"};
+
+  std::size_t slots_;
+  std::size_t running_;
+  std::array<Lane, ReturnAttribute::Lanes> lanes_;
+  bool used_;
+
+  static std::size_t DefaultSlots() {
+    if constexpr (NOBIND_PRIORITY_SLOTS > 0)
+      return NOBIND_PRIORITY_SLOTS;
+    const char *uv = std::getenv("UV_THREADPOOL_SIZE");
+    int size = uv ? std::atoi(uv) : 0;
+    // The libuv default
+    return size > 0 ? static_cast<std::size_t>(size) : 4;
+  }
+
+  // The head of each lane ranks one lane higher for every NOBIND_PRIORITY_AGING ms
+  // it has waited, ties go to the higher lane, returns Lanes if all lanes are empty
+  std::size_t Next() const {
+    auto now = std::chrono::steady_clock::now();
+    std::size_t best = ReturnAttribute::Lanes;
+    int64_t best_rank = 0;
+    for (std::size_t i = 0; i < ReturnAttribute::Lanes; i++) {
+      if (lanes_[i].waiting.empty())
+        continue;
+      auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(now - lanes_[i].waiting.front().since);
+      int64_t rank = static_cast<int64_t>(i) - waited.count() / NOBIND_PRIORITY_AGING;
+      if (best == ReturnAttribute::Lanes || rank < best_rank) {
+        best = i;
+        best_rank = rank;
+      }
+    }
+    return best;
+  }
+
+  void Dispatch() {
+    while (running_ < slots_) {
+      std::size_t lane = Next();
+      if (lane == ReturnAttribute::Lanes)
+        return;
+      Waiting next = lanes_[lane].waiting.front();
+      lanes_[lane].waiting.pop_front();
+      if (next.cancellation) {
+        next.cancellation->held = false;
+        if (next.cancellation->cancelled) {
+          lanes_[lane].cancelled++;
+          delete next.worker;
+          continue;
+        }
+      }
+      for (std::size_t i = 0; i < lane; i++) {
+        if (!lanes_[i].waiting.empty()) {
+          lanes_[lane].promoted++;
+          break;
+        }
+      }
+      lanes_[lane].dispatched++;
+      running_++;
+      next.slot->dispatcher_ = this;
+      next.worker->Queue();
+    }
+  }
+
+public:
+  AsyncDispatcher() : slots_(DefaultSlots()), running_(0), lanes_(), used_(false) {}
+
+  // A ReturnPriority binding has been registered
+  void Use() { used_ = true; }
+  bool Used() const { return used_; }
+
+  // Called on the main thread instead of Queue()
+  void Submit(Napi::AsyncWorker *worker, AsyncDispatcherSlot &slot, std::shared_ptr<CancellationState> cancellation,
+              std::size_t lane) {
+    if (cancellation)
+      cancellation->held = true;
+    lanes_[lane].waiting.push_back({worker, &slot, std::move(cancellation), std::chrono::steady_clock::now()});
+    Dispatch();
+  }
+
+  void Release() {
+    running_--;
+    Dispatch();
+  }
+
+  Napi::Object ToJS(Napi::Env env) const {
+    Napi::Object r = Napi::Object::New(env);
+    r.Set("slots", Napi::Number::New(env, static_cast<double>(slots_)));
+    r.Set("running", Napi::Number::New(env, static_cast<double>(running_)));
+    for (std::size_t i = 0; i < ReturnAttribute::Lanes; i++) {
+      Napi::Object lane = Napi::Object::New(env);
+      lane.Set("queued", Napi::Number::New(env, static_cast<double>(lanes_[i].waiting.size())));
+      lane.Set("dispatched", Napi::Number::New(env, static_cast<double>(lanes_[i].dispatched)));
+      lane.Set("promoted", Napi::Number::New(env, static_cast<double>(lanes_[i].promoted)));
+      lane.Set("cancelled", Napi::Number::New(env, static_cast<double>(lanes_[i].cancelled)));
+      r.Set(names[i], lane);
+    }
+    return r;
+  }
+};
+
+inline AsyncDispatcherSlot::~AsyncDispatcherSlot() {
+  if (dispatcher_)
+    dispatcher_->Release();
+}
+
+template <typename T = BaseEnvInstanceData> AsyncDispatcher &GetAsyncDispatcher(Napi::Env env) {
+  return env.GetInstanceData<T>()->_Nobind_async_dispatcher;
+}
+
+inline Napi::Value AsyncLanesGetter(const Napi::CallbackInfo &info) {
+  return static_cast<AsyncDispatcher *>(info.Data())->ToJS(info.Env());
+}
+
+} // namespace Nobind
@@ -0,0 +1,110 @@
+#pragma once
+#ifndef NOBIND_SHIM_PROP
+#define NOBIND_SHIM_PROP "__shim"
+#endif
+#ifndef NOBIND_SHIM_UNCHECKED_PREFIX
+#define NOBIND_SHIM_UNCHECKED_PREFIX "__nobind_unchecked_"
+#endif
+
+#include <nonapi.h>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <noattributes.h>
+#include <notypes.h>
+
+namespace Nobind {
+
+// The JS shim
+//
+// When the module is built with NOBIND_JS_SHIM, every global function has a second
+// native entry point that uses the unchecked typemaps for all its arguments. The module
+// contains the source of a CommonJS module that exports a function which receives the
+// binary module and returns its exports with every global function replaced by a JS
+// function. This JS function checks the number of arguments and the types of the
+// number and boolean arguments and then calls the unchecked entry point. The JIT can
+// inline these checks and it can often eliminate them.
+
+// The JS type checked by the shim for each JS argument produced by the C++ argument
+// at position I, it is empty when the argument is checked by C++
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS> std::vector<std::string> ShimArgChecks() {
+  using TM = FromJSArg_t<I, ARGATTR, ARGS...>;
+  if constexpr (!std::is_same_v<TM, FromJSArg_t<I, ArgWithUnchecked<ARGATTR>, ARGS...>>) {
+    // The unchecked entry point uses the unchecked typemap for this argument
+    using U = std::remove_cv_t<ArgAt_t<I, ARGS...>>;
+    return {std::is_same_v<U, bool> ? "boolean"s : "number"s};
+  } else {
+    return std::vector<std::string>(FromJSTypemapInputs<TM>(), ""s);
+  }
+}
+
+// FunctionShim is a three-stage function (refer to the comments in nofunction.h)
+// It constructs the JS shim of a global function
+// Third stage
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename... ARGS, size_t... I>
+NOBIND_INLINE std::string FunctionShim(const std::string &name, std::index_sequence<I...>) {
+  std::vector<std::vector<std::string>> checks{ShimArgChecks<I, ARGATTR, ARGS...>()...};
+  // Async functions report the argument errors by rejecting the returned Promise
+  const std::string fail = RETATTR.isAsync() ? "return Promise.reject(new TypeError("s : "throw new TypeError("s;
+  const std::string fail_end = RETATTR.isAsync() ? "));\n"s : ");\n"s;
+
+  std::string args_text, checks_text;
+  size_t inputs = 0;
+  for (size_t i = 0; i < checks.size(); i++) {
+    for (size_t k = 0; k < checks[i].size(); k++) {
+      std::string arg = "arg"s + std::to_string(i);
+      if (checks[i].size() > 1)
+        arg += "_"s + std::to_string(k);
+      args_text += (inputs > 0 ? ", "s : ""s) + arg;
+      inputs++;
+      if (!checks[i][k].empty())
+        checks_text += "      if (typeof "s + arg + " !== '"s + checks[i][k] + "') "s + fail + "'Expected a "s +
+                       checks[i][k] + "'"s + fail_end;
+    }
+  }
+
+  const std::string count = std::to_string(inputs);
+  std::string r = "  {\n"s;
+  r += "    const native = binding[\""s + NOBIND_SHIM_UNCHECKED_PREFIX + name + "\"];\n"s;
+  r += "    exports[\""s + name + "\"] = function ("s + args_text + ") {\n"s;
+  r += "      if (arguments.length !== "s + count + ") "s + fail + "'Expected "s + count +
+       " arguments, got ' + arguments.length"s + fail_end;
+  r += checks_text;
+  r += "      return native("s + args_text + ");\n"s;
+  r += "    };\n"s;
+  r += "  }\n"s;
+  return r;
+}
+
+// Second stage, two variants (except and noexcept)
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...)>
+NOBIND_INLINE std::string FunctionShim(const std::string &name, std::integral_constant<RETURN (*)(ARGS...), FUNC>) {
+  return FunctionShim<RETATTR, ARGATTR, ARGS...>(name, std::index_sequence_for<ARGS...>{});
+}
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...) noexcept>
+NOBIND_INLINE std::string FunctionShim(const std::string &name,
+                                       std::integral_constant<RETURN (*)(ARGS...) noexcept, FUNC>) {
+  return FunctionShim<RETATTR, ARGATTR, ARGS...>(name, std::index_sequence_for<ARGS...>{});
+}
+
+// First stage
+template <const ReturnAttribute &RETATTR, auto *FUNC, const ArgumentAttribute &ARGATTR = ArgumentDefault>
+std::string FunctionShim(const std::string &name) {
+  return FunctionShim<RETATTR, ARGATTR>(name, std::integral_constant<decltype(FUNC), FUNC>{});
+}
+
+// The complete shim module
+NOBIND_INLINE std::string ShimModule(const std::string &functions) {
+  std::string r = "// Generated by nobind17\n'use strict';\n\n"s;
+  r += "module.exports = function (binding) {\n"s;
+  r += "  const exports = Object.defineProperties({}, Object.getOwnPropertyDescriptors(binding));\n"s;
+  r += functions;
+  r += "  return exports;\n};\n"s;
+  return r;
+}
+
+} // namespace Nobind
@@ -0,0 +1,152 @@
+#pragma once
+#include <algorithm>
+#include <memory>
+
+#include <nohelpers.h>
+#include <nokeys.h>
+#include <noobject.h>
+#include <notypes.h>
+
+// The number of elements converted to JS in one iteration of the event loop
+#ifndef NOBIND_RESULT_SLICE_SIZE
+#define NOBIND_RESULT_SLICE_SIZE 1024
+#endif
+
+namespace Nobind {
+
+// Large async results
+//
+// With ReturnSliced and ReturnStreamed, the returned container is not converted
+// to JS in one go when the async call completes. The conversion is split in slices
+// of NOBIND_RESULT_SLICE_SIZE elements and it yields to the event loop between
+// the slices through the main thread queue.
+
+// The state shared by the slices, the jobs run in the async context of the call
+template <typename V, typename T, const ReturnAttribute &RETATTR>
+class SlicedResult : public std::enable_shared_from_this<SlicedResult<V, T, RETATTR>> {
+protected:
+  Napi::Env env_;
+  Napi::AsyncContext context_;
+  V val_;
+
+  NOBIND_INLINE Napi::Value Element(size_t i) { return ToJS<T, RetElements<RETATTR>>(env_, val_[i]).Get(); }
+
+  // Run a job on the next iteration of the event loop
+  template <typename SELF> NOBIND_INLINE void Yield(std::function<void(SELF *)> &&job) {
+    auto self = std::static_pointer_cast<SELF>(this->shared_from_this());
+    YieldToEventLoop<BaseEnvInstanceData>(env_, [self, job = std::move(job)]() {
+      Napi::HandleScope scope(self->env_);
+      Napi::CallbackScope callback(self->env_, self->context_);
+      job(self.get());
+    });
+  }
+
+public:
+  SlicedResult(Napi::Env env, V &&val, const char *name) : env_(env), context_(env, name), val_(std::move(val)) {}
+  virtual ~SlicedResult() {}
+};
+
+// ReturnSliced, a Promise resolved with an array filled by slices
+template <typename V, typename T, const ReturnAttribute &RETATTR>
+class SlicedArray : public SlicedResult<V, T, RETATTR> {
+  Napi::Promise::Deferred deferred_;
+  Napi::Reference<Napi::Array> array_;
+  size_t next_;
+
+  void Slice() {
+    try {
+      Napi::Array array = array_.Value();
+      size_t end = std::min<size_t>(next_ + NOBIND_RESULT_SLICE_SIZE, this->val_.size());
+      for (; next_ < end; next_++)
+        array.Set(static_cast<uint32_t>(next_), this->Element(next_));
+      if (next_ < this->val_.size()) {
+        this->template Yield<SlicedArray>([](SlicedArray *self) { self->Slice(); });
+      } else {
+        deferred_.Resolve(array);
+      }
+    } catch (const std::exception &e) {
+      deferred_.Reject(Napi::Error::New(this->env_, e.what()).Value());
+    }
+  }
+
+public:
+  SlicedArray(Napi::Env env, V &&val)
+      : SlicedResult<V, T, RETATTR>(env, std::move(val), "nobind_SlicedArray"),
+        deferred_(Napi::Promise::Deferred::New(env)),
+        array_(Napi::Persistent(Napi::Array::New(env, this->val_.size()))), next_(0) {}
+
+  // The first slice is converted immediately
+  static Napi::Value New(Napi::Env env, V &&val) {
+    auto self = std::make_shared<SlicedArray>(env, std::move(val));
+    self->Slice();
+    return self->deferred_.Promise();
+  }
+};
+
+// ReturnStreamed, an async iterator, the elements are converted when they are
+// iterated and the first element of each slice yields to the event loop
+template <typename V, typename T, const ReturnAttribute &RETATTR>
+class SlicedIterator : public SlicedResult<V, T, RETATTR> {
+  size_t next_;
+
+  Napi::Object IteratorResult(size_t i) {
+    Napi::Object r = Napi::Object::New(this->env_);
+    if (i < this->val_.size()) {
+      r.Set(PropertyKey<key_value>(this->env_), this->Element(i));
+      r.Set(PropertyKey<key_done>(this->env_), Napi::Boolean::New(this->env_, false));
+    } else {
+      r.Set(PropertyKey<key_done>(this->env_), Napi::Boolean::New(this->env_, true));
+    }
+    return r;
+  }
+
+  static void Settle(SlicedIterator *self, Napi::Promise::Deferred deferred, size_t i) {
+    try {
+      deferred.Resolve(self->IteratorResult(i));
+    } catch (const std::exception &e) {
+      deferred.Reject(Napi::Error::New(self->env_, e.what()).Value());
+    }
+  }
+
+  // Each call reserves its element, so the order is kept even if
+  // next() is called again before the previous Promise is resolved
+  Napi::Value Next() {
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(this->env_);
+    size_t i = next_ < this->val_.size() ? next_++ : this->val_.size();
+    if (i > 0 && i < this->val_.size() && i % NOBIND_RESULT_SLICE_SIZE == 0) {
+      this->template Yield<SlicedIterator>([deferred, i](SlicedIterator *self) { Settle(self, deferred, i); });
+    } else {
+      Settle(this, deferred, i);
+    }
+    return deferred.Promise();
+  }
+
+  // Early termination of a for await loop
+  Napi::Value Return() {
+    next_ = this->val_.size();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(this->env_);
+    Settle(this, deferred, next_);
+    return deferred.Promise();
+  }
+
+public:
+  SlicedIterator(Napi::Env env, V &&val)
+      : SlicedResult<V, T, RETATTR>(env, std::move(val), "nobind_SlicedIterator"), next_(0) {}
+
+  // The iterator keeps the container alive until it is garbage-collected
+  static Napi::Value New(Napi::Env env, V &&val) {
+    auto self = std::make_shared<SlicedIterator>(env, std::move(val));
+    Napi::Object iterator = Napi::Object::New(env);
+    iterator.Set(
+        "next", Napi::Function::New(
+                    env, [self](const Napi::CallbackInfo &) -> Napi::Value { return self->Next(); }, "next"));
+    iterator.Set(
+        "return", Napi::Function::New(
+                      env, [self](const Napi::CallbackInfo &) -> Napi::Value { return self->Return(); }, "return"));
+    iterator.Set(Napi::Symbol::WellKnown(env, "asyncIterator"),
+                 Napi::Function::New(env, [](const Napi::CallbackInfo &info) -> Napi::Value { return info.This(); }));
+    return iterator;
+  }
+};
+
+} // namespace Nobind
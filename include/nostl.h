@@ -1,5 +1,7 @@
 #pragma once
 #include <map>
+#include <nokeys.h>
+#include <noslice.h>
 #include <notypes.h>
 #include <notypescript.h>
 #include <string>
@@ -7,6 +9,10 @@
 
 namespace Nobind {
 
+// The ReturnStructOfArrays conversion of reflected structs is implemented in nostruct.h
+template <typename S> Napi::Value ToJSStructOfArrays(Napi::Env env, const std::vector<S> &val);
+template <typename S> std::string StructOfArraysTSType();
+
 namespace Typemap {
 
 template <typename V, typename T> class FromJSVector {
@@ -14,19 +20,23 @@ template <typename V, typename T> class FromJSVector {
   size_t len_;
   std::vector<FromJS_t<T>> tms_;
 
-public:
-  NOBIND_INLINE explicit FromJSVector(const Napi::Value &val) {
+  template <bool DEFERRED> NOBIND_INLINE void Capture(const Napi::Value &val) {
     if (!val.IsArray()) {
       throw Napi::TypeError::New(val.Env(), "Expected an array");
     }
     Napi::Array array = val.As<Napi::Array>();
     len_ = array.Length();
     tms_.reserve(len_);
-    for (size_t i = 0; i < array.Length(); i++) {
-      tms_.emplace_back(array.Get(i));
+    for (size_t i = 0; i < len_; i++) {
+      tms_.push_back(FromJSTypemapValue<FromJS_t<T>, DEFERRED>(array.Get(i)));
     }
   }
 
+public:
+  NOBIND_INLINE explicit FromJSVector(const Napi::Value &val) { Capture<false>(val); }
+  // In deferred mode, the elements are also captured in deferred mode
+  NOBIND_INLINE FromJSVector(const Napi::Value &val, FromJSDeferred) { Capture<true>(val); }
+
 #ifndef NOBIND_NO_ASYNC_LOCKING
   NOBIND_INLINE void Lock() NOBIND_NOEXCEPT {
     if constexpr (FromJSTypemapHasLocking<FromJS_t<T>>::lock) {
@@ -65,16 +75,32 @@ template <typename V, typename T, const ReturnAttribute &RETATTR> class ToJSVect
 public:
   NOBIND_INLINE explicit ToJSVector(Napi::Env env, V val) : env_(env), val_(val) {}
   NOBIND_INLINE Napi::Value Get() {
-    Napi::Array array = Napi::Array::New(env_, val_.size());
-    for (size_t i = 0; i < val_.size(); i++) {
-      array.Set(i, ToJS<T, RETATTR>(env_, val_[i]).Get());
+    if constexpr (RETATTR.isStructOfArrays()) {
+      return ToJSStructOfArrays(env_, val_);
+    } else if constexpr (RETATTR.isSliced()) {
+      return SlicedArray<std::remove_cv_t<std::remove_reference_t<V>>, T, RETATTR>::New(env_, std::move(val_));
+    } else if constexpr (RETATTR.isStreamed()) {
+      return SlicedIterator<std::remove_cv_t<std::remove_reference_t<V>>, T, RETATTR>::New(env_, std::move(val_));
+    } else {
+      Napi::Array array = Napi::Array::New(env_, val_.size());
+      for (size_t i = 0; i < val_.size(); i++) {
+        array.Set(i, ToJS<T, RETATTR>(env_, val_[i]).Get());
+      }
+      return array;
     }
-    return array;
   }
   ToJSVector(const ToJSVector &) = delete;
   ToJSVector(ToJSVector &&) = default;
 
-  static std::string TSType() { return createTSArray<T>(); };
+  static std::string TSType() {
+    if constexpr (RETATTR.isStructOfArrays()) {
+      return StructOfArraysTSType<T>();
+    } else if constexpr (RETATTR.isStreamed()) {
+      return "AsyncIterableIterator<"s + FromTSType<T>() + ">"s;
+    } else {
+      return createTSArray<T>();
+    }
+  };
 };
 
 template <typename M, typename T> class FromJSMap {
@@ -82,19 +108,22 @@ template <typename M, typename T> class FromJSMap {
   size_t len_;
   std::map<std::string, FromJS_t<T>> tms_;
 
-public:
-  NOBIND_INLINE explicit FromJSMap(const Napi::Value &val) {
+  // The values are converted only by Get()
+  template <bool DEFERRED> NOBIND_INLINE void Capture(const Napi::Value &val) {
     if (!val.IsObject()) {
       throw Napi::TypeError::New(val.Env(), "Expected an object");
     }
     Napi::Object object = val.ToObject();
     for (auto prop : object) {
-      auto tm = FromJSValue<T>(prop.second);
-      tms_.emplace(prop.first.ToString().Utf8Value(), prop.second);
-      val_.insert({prop.first.ToString().Utf8Value(), tm.Get()});
+      tms_.emplace(prop.first.ToString().Utf8Value(), FromJSTypemapValue<FromJS_t<T>, DEFERRED>(prop.second));
     }
   }
 
+public:
+  NOBIND_INLINE explicit FromJSMap(const Napi::Value &val) { Capture<false>(val); }
+  // In deferred mode, the values are also captured in deferred mode
+  NOBIND_INLINE FromJSMap(const Napi::Value &val, FromJSDeferred) { Capture<true>(val); }
+
   NOBIND_INLINE M Get() {
     for (auto &el : tms_) {
       val_.insert({el.first, el.second.Get()});
@@ -135,7 +164,8 @@ public:
   NOBIND_INLINE Napi::Value Get() {
     Napi::Object object = Napi::Object::New(env_);
     for (auto &prop : val_) {
-      object.Set(Napi::String::New(env_, prop.first), ToJS<T, RETATTR>(env_, prop.second).Get());
+      object.Set(NewPropertyKey(env_, prop.first.c_str(), prop.first.size()),
+                 ToJS<T, RETATTR>(env_, prop.second).Get());
     }
     return object;
   }
@@ -1,21 +1,271 @@
 #pragma once
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <noobject.h>
 #include <notypes.h>
 
+#ifndef NOBIND_STRING_BUFFER_SIZE
+#define NOBIND_STRING_BUFFER_SIZE 256
+#endif
+
 namespace Nobind {
 
+// The Node-API getters for each string encoding
+struct NapiGetStringUtf8 {
+  using type = char;
+  static NOBIND_INLINE napi_status Get(napi_env env, napi_value val, type *buf, size_t size, size_t *r) {
+    return napi_get_value_string_utf8(env, val, buf, size, r);
+  }
+};
+struct NapiGetStringLatin1 {
+  using type = char;
+  static NOBIND_INLINE napi_status Get(napi_env env, napi_value val, type *buf, size_t size, size_t *r) {
+    return napi_get_value_string_latin1(env, val, buf, size, r);
+  }
+};
+struct NapiGetStringUtf16 {
+  using type = char16_t;
+  static NOBIND_INLINE napi_status Get(napi_env env, napi_value val, type *buf, size_t size, size_t *r) {
+    return napi_get_value_string_utf16(env, val, buf, size, r);
+  }
+};
+
+// The value of a JS string in the encoding of GETTER, short strings are
+// stored inline and only strings longer than NOBIND_STRING_BUFFER_SIZE bytes
+// are allocated on the heap
+template <typename GETTER> class BasicStringBuffer {
+  using CHAR = typename GETTER::type;
+  static constexpr size_t inline_size = NOBIND_STRING_BUFFER_SIZE / sizeof(CHAR);
+
+  CHAR inline_[inline_size];
+  std::unique_ptr<CHAR[]> heap_;
+  CHAR *data_;
+  size_t len_;
+
+public:
+  NOBIND_INLINE explicit BasicStringBuffer(const Napi::Value &val) : data_(inline_) {
+    napi_env env = val.Env();
+    if (GETTER::Get(env, val, inline_, inline_size, &len_) != napi_ok) {
+      throw Napi::TypeError::New(val.Env(), "Expected a string");
+    }
+    // V8 never splits a multi-byte character, so a UTF-8 string that filled
+    // the buffer up to its last 3 bytes may have been truncated
+    if (len_ + 4 >= inline_size) {
+      size_t full;
+      GETTER::Get(env, val, nullptr, 0, &full);
+      if (full > len_) {
+        heap_ = std::make_unique<CHAR[]>(full + 1);
+        GETTER::Get(env, val, heap_.get(), full + 1, &len_);
+        data_ = heap_.get();
+      }
+    }
+  }
+
+  // The inline buffer cannot be stolen
+  NOBIND_INLINE BasicStringBuffer(BasicStringBuffer &&other) : heap_(std::move(other.heap_)), len_(other.len_) {
+    if (heap_) {
+      data_ = heap_.get();
+    } else {
+      memcpy(inline_, other.inline_, (len_ + 1) * sizeof(CHAR));
+      data_ = inline_;
+    }
+  }
+  BasicStringBuffer(const BasicStringBuffer &) = delete;
+
+  NOBIND_INLINE CHAR *Data() { return data_; }
+  NOBIND_INLINE size_t Size() const { return len_; }
+
+  // Convert directly to a C++ string, a long string is written only once
+  // in its final storage without an intermediate heap buffer
+  NOBIND_INLINE static void Read(const Napi::Value &val, std::basic_string<CHAR> &out) {
+    napi_env env = val.Env();
+    CHAR buf[inline_size];
+    size_t len;
+    if (GETTER::Get(env, val, buf, inline_size, &len) != napi_ok) {
+      throw Napi::TypeError::New(val.Env(), "Expected a string");
+    }
+    if (len + 4 >= inline_size) {
+      size_t full;
+      GETTER::Get(env, val, nullptr, 0, &full);
+      if (full > len) {
+        // The terminating null goes to out[full]
+        out.resize(full);
+        GETTER::Get(env, val, out.data(), full + 1, &len);
+        out.resize(len);
+        return;
+      }
+    }
+    out.assign(buf, len);
+  }
+};
+
+using StringBuffer = BasicStringBuffer<NapiGetStringUtf8>;
+using Latin1StringBuffer = BasicStringBuffer<NapiGetStringLatin1>;
+using U16StringBuffer = BasicStringBuffer<NapiGetStringUtf16>;
+
+#if defined(NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS) || NAPI_VERSION >= 10
+#define NOBIND_EXTERNAL_STRINGS
+#endif
+
+#ifdef NOBIND_EXTERNAL_STRINGS
+// Create a JS string that references the C++ memory without copying it,
+// returns nullptr when the string cannot be externalized
+template <const ReturnAttribute &RETATTR, typename CHAR>
+NOBIND_INLINE napi_value NewExternalString(Napi::Env env, const CHAR *data, size_t len) {
+  napi_value r;
+  bool copied;
+  napi_status status;
+  if constexpr (std::is_same_v<CHAR, char16_t>) {
+    status = node_api_create_external_string_utf16(env, const_cast<char16_t *>(data), len, nullptr, nullptr, &r,
+                                                   &copied);
+  } else {
+    if (len == NAPI_AUTO_LENGTH)
+      len = strlen(data);
+    // UTF-8 and Latin-1 are the same only for ASCII
+    if constexpr (!RETATTR.isLatin1()) {
+      for (size_t i = 0; i < len; i++)
+        if (static_cast<unsigned char>(data[i]) >= 0x80)
+          return nullptr;
+    }
+    status = node_api_create_external_string_latin1(env, const_cast<char *>(data), len, nullptr, nullptr, &r, &copied);
+  }
+  if (status != napi_ok)
+    return nullptr;
+  return r;
+}
+#endif
+
+// Create a JS string from UTF-8, UTF-16 or, with ReturnLatin1, from Latin-1
+// With ReturnShared, C++ strings that outlive the call (LONGLIVED) are not
+// copied to the JS heap when the runtime supports external strings
+template <const ReturnAttribute &RETATTR, bool LONGLIVED, typename CHAR>
+NOBIND_INLINE Napi::Value NewStringValue(Napi::Env env, const CHAR *data, size_t len) {
+#ifdef NOBIND_EXTERNAL_STRINGS
+  if constexpr (LONGLIVED && RETATTR.isShared()) {
+    napi_value r = NewExternalString<RETATTR>(env, data, len);
+    if (r != nullptr)
+      return Napi::Value(env, r);
+  }
+#endif
+  if constexpr (RETATTR.isLatin1()) {
+    static_assert(std::is_same_v<CHAR, char>, "ReturnLatin1 is valid only for 8-bit strings");
+    napi_value r;
+    if (napi_create_string_latin1(env, data, len, &r) != napi_ok) {
+      throw Napi::Error::New(env, "Failed to create a Latin-1 string");
+    }
+    return Napi::Value(env, r);
+  } else {
+    return Napi::String::New(env, data, len);
+  }
+}
+
+// Create a JS string, with ReturnInterned, the JS string is looked up first
+// in the interned strings table of the environment
+template <const ReturnAttribute &RETATTR, bool LONGLIVED = true, typename CHAR>
+NOBIND_INLINE Napi::Value NewString(Napi::Env env, const CHAR *data, size_t len) {
+  if constexpr (RETATTR.isInterned()) {
+    static_assert(std::is_same_v<CHAR, char>, "ReturnInterned is valid only for 8-bit strings");
+    InternedStrings *interned = env.GetInstanceData<BaseEnvInstanceData>()->_Nobind_interned_strings;
+    if (interned != nullptr) {
+      std::string_view key = len == NAPI_AUTO_LENGTH ? std::string_view(data) : std::string_view(data, len);
+      Napi::Value js = interned->Get(key);
+      if (js.IsEmpty()) {
+        js = NewStringValue<RETATTR, LONGLIVED>(env, key.data(), key.size());
+        interned->Put(key, js);
+      }
+      return js;
+    }
+  }
+  return NewStringValue<RETATTR, LONGLIVED>(env, data, len);
+}
+
+// Transcode UTF-16 to UTF-8, lone surrogates are replaced by U+FFFD like V8 does
+NOBIND_INLINE void Utf16ToUtf8(const char16_t *src, size_t len, std::string &dst) {
+  auto codepoint = [src, len](size_t &i) -> char32_t {
+    char32_t c = src[i++];
+    if (c >= 0xD800 && c <= 0xDBFF && i < len && src[i] >= 0xDC00 && src[i] <= 0xDFFF)
+      return 0x10000 + ((c - 0xD800) << 10) + (src[i++] - 0xDC00);
+    if (c >= 0xD800 && c <= 0xDFFF)
+      return 0xFFFD;
+    return c;
+  };
+  size_t size = 0;
+  for (size_t i = 0; i < len;) {
+    char32_t c = codepoint(i);
+    size += c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+  }
+  dst.resize(size);
+  char *out = dst.data();
+  for (size_t i = 0; i < len;) {
+    char32_t c = codepoint(i);
+    if (c < 0x80) {
+      *out++ = static_cast<char>(c);
+    } else if (c < 0x800) {
+      *out++ = static_cast<char>(0xC0 | (c >> 6));
+      *out++ = static_cast<char>(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+      *out++ = static_cast<char>(0xE0 | (c >> 12));
+      *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+      *out++ = static_cast<char>(0x80 | (c & 0x3F));
+    } else {
+      *out++ = static_cast<char>(0xF0 | (c >> 18));
+      *out++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+      *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+      *out++ = static_cast<char>(0x80 | (c & 0x3F));
+    }
+  }
+}
+
 namespace Typemap {
 
-template <typename T> class FromJSString {
+template <typename T, typename BUFFER = StringBuffer> class FromJSString {
   std::remove_cv_t<std::remove_reference_t<T>> val_;
+  std::u16string raw_;
+  bool deferred_;
 
 public:
-  NOBIND_INLINE explicit FromJSString(const Napi::Value &val) {
-    if (!val.IsString()) {
+  NOBIND_INLINE explicit FromJSString(const Napi::Value &val) : deferred_(false) { BUFFER::Read(val, val_); }
+  // In deferred mode, long non-ASCII strings are copied as UTF-16 on the main thread
+  // and they are transcoded by Get() on the worker thread
+  // (Node-API cannot tell one-byte strings apart, but ASCII strings have the same length
+  // in UTF-8 and UTF-16 and have nothing to transcode - they are copied once as UTF-8)
+  template <typename B = BUFFER, typename = std::enable_if_t<std::is_same_v<B, StringBuffer>>>
+  NOBIND_INLINE FromJSString(const Napi::Value &val, FromJSDeferred) : deferred_(false) {
+    size_t len, utf8_len;
+    if (napi_get_value_string_utf16(val.Env(), val, nullptr, 0, &len) != napi_ok) {
       throw Napi::TypeError::New(val.Env(), "Expected a string");
     }
-    val_ = val.ToString().Utf8Value();
+    if (len < NOBIND_STRING_BUFFER_SIZE) {
+      BUFFER::Read(val, val_);
+      return;
+    }
+    napi_get_value_string_utf8(val.Env(), val, nullptr, 0, &utf8_len);
+    if (utf8_len == len) {
+      // The terminating null goes to val_[len]
+      val_.resize(len);
+      napi_get_value_string_utf8(val.Env(), val, val_.data(), len + 1, &len);
+      return;
+    }
+    raw_.resize(len);
+    napi_get_value_string_utf16(val.Env(), val, raw_.data(), len + 1, &len);
+    deferred_ = true;
+  }
+  NOBIND_INLINE T Get() {
+    if constexpr (std::is_same_v<BUFFER, StringBuffer>) {
+      if (deferred_) {
+        Utf16ToUtf8(raw_.data(), raw_.size(), val_);
+        raw_.clear();
+        deferred_ = false;
+      }
+    }
+    return val_;
   }
-  NOBIND_INLINE T Get() { return val_; }
+  // Is the transcoding still pending
+  NOBIND_INLINE bool Deferred() const { return deferred_; }
   FromJSString(const FromJSString &) = delete;
   FromJSString(FromJSString &&) = default;
 };
@@ -26,28 +276,21 @@ template <typename T, const ReturnAttribute &RETATTR> class ToJSString {
 
 public:
   NOBIND_INLINE explicit ToJSString(Napi::Env env, T val) : env_(env), val_(val) {}
-  NOBIND_INLINE Napi::Value Get() { return Napi::String::New(env_, val_); }
+  NOBIND_INLINE Napi::Value Get() {
+    return NewString<RETATTR, std::is_reference_v<T>>(env_, val_.data(), val_.size());
+  }
   ToJSString(const ToJSString &) = delete;
   ToJSString(ToJSString &&) = default;
 };
 
-template <typename T> class FromJSChar {
-  char *val_;
+// C++ receives a pointer to the conversion buffer that
+// remains valid for the duration of the call
+template <typename T, typename BUFFER = StringBuffer> class FromJSChar {
+  BUFFER val_;
 
 public:
-  NOBIND_INLINE explicit FromJSChar(const Napi::Value &val) {
-    if (!val.IsString()) {
-      throw Napi::TypeError::New(val.Env(), "Expected a string");
-    }
-    std::string s = val.ToString().Utf8Value();
-    val_ = new char[s.size() + 1];
-    strncpy(val_, s.c_str(), s.size());
-    val_[s.size()] = 0;
-  }
-
-  NOBIND_INLINE T Get() { return val_; }
-
-  ~FromJSChar() { delete val_; }
+  NOBIND_INLINE explicit FromJSChar(const Napi::Value &val) : val_(val) {}
+  NOBIND_INLINE T Get() { return val_.Data(); }
   FromJSChar(const FromJSChar &) = delete;
   FromJSChar(FromJSChar &&) = default;
 };
@@ -58,16 +301,57 @@ template <typename T, const ReturnAttribute &RETATTR> class ToJSChar {
 
 public:
   NOBIND_INLINE explicit ToJSChar(Napi::Env env, T val) : env_(env), val_(val) {}
-  NOBIND_INLINE Napi::Value Get() { return Napi::String::New(env_, val_); }
+  NOBIND_INLINE Napi::Value Get() {
+    if (val_ == nullptr) {
+      throw Napi::Error::New(env_, "Returned nullptr");
+    }
+    return NewString<RETATTR>(env_, val_, NAPI_AUTO_LENGTH);
+  }
   ToJSChar(const ToJSChar &) = delete;
   ToJSChar(ToJSChar &&) = default;
 };
 
+// A string view points to the conversion buffer
+template <typename T, typename BUFFER = StringBuffer> class FromJSStringView {
+  BUFFER val_;
+
+public:
+  NOBIND_INLINE explicit FromJSStringView(const Napi::Value &val) : val_(val) {}
+  NOBIND_INLINE T Get() { return std::remove_cv_t<T>(val_.Data(), val_.Size()); }
+  FromJSStringView(const FromJSStringView &) = delete;
+  FromJSStringView(FromJSStringView &&) = default;
+};
+
+template <typename T, const ReturnAttribute &RETATTR> class ToJSStringView {
+  Napi::Env env_;
+  T val_;
+
+public:
+  NOBIND_INLINE explicit ToJSStringView(Napi::Env env, T val) : env_(env), val_(val) {}
+  NOBIND_INLINE Napi::Value Get() { return NewString<RETATTR>(env_, val_.data(), val_.size()); }
+  ToJSStringView(const ToJSStringView &) = delete;
+  ToJSStringView(ToJSStringView &&) = default;
+};
+
 const std::string string_tstype = "string"s;
 
-#define TYPEMAPS_FOR_STRING(TYPE, CLASS)                                                                               \
-  template <> struct FromJS<TYPE> : public FromJS##CLASS<TYPE> {                                                       \
-    using FromJS##CLASS<TYPE>::FromJS##CLASS;                                                                          \
+#define TYPEMAPS_FOR_STRING(TYPE, CLASS, BUFFER)                                                                       \
+  template <> struct FromJS<TYPE> : public FromJS##CLASS<TYPE, BUFFER> {                                               \
+    using FromJS##CLASS<TYPE, BUFFER>::FromJS##CLASS;                                                                  \
+    static const std::string &TSType() { return string_tstype; };                                                      \
+  };                                                                                                                   \
+  template <> struct FromJSLatin1<TYPE> : public FromJS##CLASS<TYPE, Latin1StringBuffer> {                             \
+    using FromJS##CLASS<TYPE, Latin1StringBuffer>::FromJS##CLASS;                                                      \
+    static const std::string &TSType() { return string_tstype; };                                                      \
+  };                                                                                                                   \
+  template <const ReturnAttribute &RETATTR> struct ToJS<TYPE, RETATTR> : public ToJS##CLASS<TYPE, RETATTR> {           \
+    using ToJS##CLASS<TYPE, RETATTR>::ToJS##CLASS;                                                                     \
+    static const std::string &TSType() { return string_tstype; };                                                      \
+  };
+
+#define TYPEMAPS_FOR_U16STRING(TYPE, CLASS)                                                                            \
+  template <> struct FromJS<TYPE> : public FromJS##CLASS<TYPE, U16StringBuffer> {                                      \
+    using FromJS##CLASS<TYPE, U16StringBuffer>::FromJS##CLASS;                                                         \
     static const std::string &TSType() { return string_tstype; };                                                      \
   };                                                                                                                   \
   template <const ReturnAttribute &RETATTR> struct ToJS<TYPE, RETATTR> : public ToJS##CLASS<TYPE, RETATTR> {           \
@@ -77,17 +361,32 @@ const std::string string_tstype = "string"s;
 
 // The const versions are needed to ensure that we
 // do not end up using the T& specialization (ie we are always more specialized)
-TYPEMAPS_FOR_STRING(std::string, String);
-TYPEMAPS_FOR_STRING(const std::string, String);
-TYPEMAPS_FOR_STRING(std::string &, String);
-TYPEMAPS_FOR_STRING(const std::string &, String);
+TYPEMAPS_FOR_STRING(std::string, String, StringBuffer);
+TYPEMAPS_FOR_STRING(const std::string, String, StringBuffer);
+TYPEMAPS_FOR_STRING(std::string &, String, StringBuffer);
+TYPEMAPS_FOR_STRING(const std::string &, String, StringBuffer);
 
 // remove_const_t<const char*> == const char* (it is a pointer before being a const)
 // remove_const_t<char const*> == char* (but few people use this notation)
 // remove_pointer_t<const char*> == const char
 // remove_const_t<remove_pointer_t<const char *>> == char
-TYPEMAPS_FOR_STRING(char *, Char);
-TYPEMAPS_FOR_STRING(const char *, Char);
+TYPEMAPS_FOR_STRING(char *, Char, StringBuffer);
+TYPEMAPS_FOR_STRING(const char *, Char, StringBuffer);
+
+TYPEMAPS_FOR_STRING(std::string_view, StringView, StringBuffer);
+TYPEMAPS_FOR_STRING(const std::string_view, StringView, StringBuffer);
+
+// UTF-16 strings are copied without any transcoding
+TYPEMAPS_FOR_U16STRING(std::u16string, String);
+TYPEMAPS_FOR_U16STRING(const std::u16string, String);
+TYPEMAPS_FOR_U16STRING(std::u16string &, String);
+TYPEMAPS_FOR_U16STRING(const std::u16string &, String);
+
+TYPEMAPS_FOR_U16STRING(char16_t *, Char);
+TYPEMAPS_FOR_U16STRING(const char16_t *, Char);
+
+TYPEMAPS_FOR_U16STRING(std::u16string_view, StringView);
+TYPEMAPS_FOR_U16STRING(const std::u16string_view, StringView);
 
 } // namespace Typemap
 
@@ -0,0 +1,281 @@
+#pragma once
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <nokeys.h>
+#include <notypedarray.h>
+#include <notypes.h>
+#include <notypescript.h>
+
+namespace Nobind {
+
+// A field of a reflected struct
+template <typename S, typename T> struct StructField {
+  using type = T;
+  const char *name;
+  T S::*member;
+};
+
+template <typename S, typename T> constexpr StructField<S, T> MakeStructField(const char *name, T S::*member) {
+  return StructField<S, T>{name, member};
+}
+
+// The fields of a reflected struct, specialized by NOBIND_STRUCT
+// (it contains a constexpr tuple of StructField named fields)
+template <typename S> struct StructFields;
+
+template <typename S> constexpr size_t StructFieldsCount = std::tuple_size_v<decltype(StructFields<S>::fields)>;
+
+// The first property key index of the fields of a reflected struct
+template <typename S> size_t StructKeyBase() {
+  static const size_t base = PropertyKeys::Register(StructFieldsCount<S>);
+  return base;
+}
+
+// The property key of the field at position I
+template <typename S, size_t I> NOBIND_INLINE Napi::Value StructKey(Napi::Env env) {
+  return PropertyKey(env, StructKeyBase<S>() + I, std::get<I>(StructFields<S>::fields).name);
+}
+
+template <typename S, bool TOJS, size_t... I> std::string StructTSType(std::index_sequence<I...>) {
+  std::string r = "{ "s;
+  ((r += std::get<I>(StructFields<S>::fields).name + ": "s +
+         (TOJS ? ToTSType<typename std::tuple_element_t<I, decltype(StructFields<S>::fields)>::type>()
+               : FromTSType<typename std::tuple_element_t<I, decltype(StructFields<S>::fields)>::type>()) +
+         "; "s),
+   ...);
+  return r + "}"s;
+}
+
+// The struct-of-arrays layout of a vector of reflected structs is an object
+// with one TypedArray per field, all fields must be arithmetic types
+template <typename S, size_t I>
+using StructFieldType_t = typename std::tuple_element_t<I, decltype(StructFields<S>::fields)>::type;
+
+template <typename S, size_t I>
+NOBIND_INLINE napi_property_descriptor StructOfArraysColumn(Napi::Env env, const std::vector<S> &val) {
+  using F = StructFieldType_t<S, I>;
+  static_assert(std::is_arithmetic_v<F> && !std::is_same_v<F, bool>,
+                "ReturnStructOfArrays requires structs with arithmetic fields");
+  constexpr auto member = std::get<I>(StructFields<S>::fields).member;
+  Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env, val.size() * sizeof(F));
+  F *data = static_cast<F *>(buffer.Data());
+  for (size_t i = 0; i < val.size(); i++) {
+    data[i] = val[i].*member;
+  }
+  napi_value column;
+  if (napi_create_typedarray(env, TypedArrayTypeOf<F>(), val.size(), buffer, 0, &column) != napi_ok) {
+    throw Napi::Error::New(env, "Failed to create a TypedArray");
+  }
+  return {nullptr, StructKey<S, I>(env), nullptr, nullptr, nullptr, column, napi_default_jsproperty, nullptr};
+}
+
+template <typename S, size_t... I>
+NOBIND_INLINE Napi::Value ToJSStructOfArrays(Napi::Env env, const std::vector<S> &val, std::index_sequence<I...>) {
+  napi_property_descriptor props[] = {StructOfArraysColumn<S, I>(env, val)...};
+  Napi::Object obj = Napi::Object::New(env);
+  if (napi_define_properties(env, obj, sizeof...(I), props) != napi_ok) {
+    throw Napi::Error::New(env, "Failed to create the object");
+  }
+  return obj;
+}
+
+template <typename S> NOBIND_INLINE Napi::Value ToJSStructOfArrays(Napi::Env env, const std::vector<S> &val) {
+  return ToJSStructOfArrays(env, val, std::make_index_sequence<StructFieldsCount<S>>{});
+}
+
+template <typename S, size_t... I> std::string StructOfArraysTSType(std::index_sequence<I...>) {
+  std::string r = "{ "s;
+  ((r += std::get<I>(StructFields<S>::fields).name + ": "s +
+         TypedArrayName(TypedArrayTypeOf<StructFieldType_t<S, I>>()) + "; "s),
+   ...);
+  return r + "}"s;
+}
+
+template <typename S> std::string StructOfArraysTSType() {
+  return StructOfArraysTSType<S>(std::make_index_sequence<StructFieldsCount<S>>{});
+}
+
+namespace Typemap {
+
+// When calling C++ with a plain JS object, C++ receives a copy
+// of the struct with every field converted by its own typemap
+template <typename T> class FromJSStruct {
+  using S = std::remove_cv_t<std::remove_reference_t<T>>;
+  S val_;
+
+  template <size_t I> NOBIND_INLINE void ReadField(const Napi::Object &obj) {
+    constexpr auto field = std::get<I>(StructFields<S>::fields);
+    using F = typename decltype(field)::type;
+    val_.*field.member = FromJSValue<F>(obj.Get(StructKey<S, I>(obj.Env()))).Get();
+  }
+
+  template <size_t... I> NOBIND_INLINE void ReadFields(const Napi::Object &obj, std::index_sequence<I...>) {
+    (ReadField<I>(obj), ...);
+  }
+
+public:
+  NOBIND_INLINE explicit FromJSStruct(const Napi::Value &val) {
+    if (!val.IsObject()) {
+      throw Napi::TypeError::New(val.Env(), "Expected an object");
+    }
+    ReadFields(val.ToObject(), std::make_index_sequence<StructFieldsCount<S>>{});
+  }
+  NOBIND_INLINE T Get() { return val_; }
+  FromJSStruct(const FromJSStruct &) = delete;
+  FromJSStruct(FromJSStruct &&) = default;
+
+  static std::string TSType() { return StructTSType<S, false>(std::make_index_sequence<StructFieldsCount<S>>{}); }
+};
+
+// When C++ returns a struct, JS receives a plain object
+// constructed with a single napi_define_properties call
+template <typename T, const ReturnAttribute &RETATTR> class ToJSStruct {
+  using S = std::remove_cv_t<std::remove_reference_t<T>>;
+  Napi::Env env_;
+  S val_;
+
+  template <size_t I> NOBIND_INLINE napi_property_descriptor Describe() {
+    constexpr auto field = std::get<I>(StructFields<S>::fields);
+    using F = typename decltype(field)::type;
+    napi_value value = ToJS<F, ReturnDefault>(env_, val_.*field.member).Get();
+    return {nullptr, StructKey<S, I>(env_), nullptr, nullptr, nullptr, value, napi_default_jsproperty, nullptr};
+  }
+
+  template <size_t... I> NOBIND_INLINE Napi::Value Create(std::index_sequence<I...>) {
+    napi_property_descriptor props[] = {Describe<I>()...};
+    Napi::Object obj = Napi::Object::New(env_);
+    if (napi_define_properties(env_, obj, sizeof...(I), props) != napi_ok) {
+      throw Napi::Error::New(env_, "Failed to create the object");
+    }
+    return obj;
+  }
+
+public:
+  NOBIND_INLINE explicit ToJSStruct(Napi::Env env, T val) : env_(env), val_(val) {}
+  NOBIND_INLINE Napi::Value Get() { return Create(std::make_index_sequence<StructFieldsCount<S>>{}); }
+  ToJSStruct(const ToJSStruct &) = delete;
+  ToJSStruct(ToJSStruct &&) = default;
+
+  static std::string TSType() { return StructTSType<S, true>(std::make_index_sequence<StructFieldsCount<S>>{}); }
+};
+
+// When calling C++ with an object of TypedArrays, C++ receives
+// a vector of structs, one for each element of the TypedArrays
+template <typename S> class FromJSStructOfArraysVector {
+  std::vector<S> val_;
+
+  template <size_t I> NOBIND_INLINE void ReadColumn(const Napi::Object &obj, size_t &len) {
+    using F = StructFieldType_t<S, I>;
+    static_assert(std::is_arithmetic_v<F> && !std::is_same_v<F, bool>,
+                  "ArgStructOfArrays requires structs with arithmetic fields");
+    constexpr auto member = std::get<I>(StructFields<S>::fields).member;
+    FromJSTypedArray<const F> column(obj.Get(StructKey<S, I>(obj.Env())));
+    const F *data = column.template Get<0>();
+    if (I == 0) {
+      len = column.template Get<1>();
+      val_.resize(len);
+    } else if (column.template Get<1>() != len) {
+      throw Napi::RangeError::New(obj.Env(), "All TypedArrays must have the same length");
+    }
+    for (size_t i = 0; i < len; i++) {
+      val_[i].*member = data[i];
+    }
+  }
+
+  template <size_t... I> NOBIND_INLINE void ReadColumns(const Napi::Object &obj, std::index_sequence<I...>) {
+    size_t len = 0;
+    (ReadColumn<I>(obj, len), ...);
+  }
+
+public:
+  NOBIND_INLINE explicit FromJSStructOfArraysVector(const Napi::Value &val) {
+    if (!val.IsObject()) {
+      throw Napi::TypeError::New(val.Env(), "Expected an object");
+    }
+    ReadColumns(val.ToObject(), std::make_index_sequence<StructFieldsCount<S>>{});
+  }
+  FromJSStructOfArraysVector(const FromJSStructOfArraysVector &) = delete;
+  FromJSStructOfArraysVector(FromJSStructOfArraysVector &&) = default;
+
+  static std::string TSType() { return StructOfArraysTSType<S>(); }
+
+protected:
+  NOBIND_INLINE std::vector<S> &Value() { return val_; }
+};
+
+template <typename S> class FromJSStructOfArrays<std::vector<S>> : public FromJSStructOfArraysVector<S> {
+public:
+  using FromJSStructOfArraysVector<S>::FromJSStructOfArraysVector;
+  NOBIND_INLINE std::vector<S> Get() { return std::move(this->Value()); }
+};
+
+template <typename S> class FromJSStructOfArrays<const std::vector<S> &> : public FromJSStructOfArraysVector<S> {
+public:
+  using FromJSStructOfArraysVector<S>::FromJSStructOfArraysVector;
+  NOBIND_INLINE const std::vector<S> &Get() { return this->Value(); }
+};
+
+} // namespace Typemap
+
+} // namespace Nobind
+
+// Preprocessor iteration over the field names
+// (the recursion is limited only by the number of NOBIND_EVAL passes)
+#define NOBIND_EVAL0(...) __VA_ARGS__
+#define NOBIND_EVAL1(...) NOBIND_EVAL0(NOBIND_EVAL0(NOBIND_EVAL0(__VA_ARGS__)))
+#define NOBIND_EVAL2(...) NOBIND_EVAL1(NOBIND_EVAL1(NOBIND_EVAL1(__VA_ARGS__)))
+#define NOBIND_EVAL3(...) NOBIND_EVAL2(NOBIND_EVAL2(NOBIND_EVAL2(__VA_ARGS__)))
+#define NOBIND_EVAL(...) NOBIND_EVAL3(NOBIND_EVAL3(NOBIND_EVAL3(__VA_ARGS__)))
+#define NOBIND_MAP_END(...)
+#define NOBIND_MAP_OUT
+#define NOBIND_MAP_COMMA ,
+#define NOBIND_MAP_GET_END2() 0, NOBIND_MAP_END
+#define NOBIND_MAP_GET_END1(...) NOBIND_MAP_GET_END2
+#define NOBIND_MAP_GET_END(...) NOBIND_MAP_GET_END1
+#define NOBIND_MAP_NEXT0(test, next, ...) next NOBIND_MAP_OUT
+#define NOBIND_MAP_LIST_NEXT1(test, next) NOBIND_MAP_NEXT0(test, NOBIND_MAP_COMMA next, 0)
+#define NOBIND_MAP_LIST_NEXT(test, next) NOBIND_MAP_LIST_NEXT1(NOBIND_MAP_GET_END test, next)
+#define NOBIND_MAP_LIST0(f, ud, x, peek, ...)                                                                          \
+  f(ud, x) NOBIND_MAP_LIST_NEXT(peek, NOBIND_MAP_LIST1)(f, ud, peek, __VA_ARGS__)
+#define NOBIND_MAP_LIST1(f, ud, x, peek, ...)                                                                          \
+  f(ud, x) NOBIND_MAP_LIST_NEXT(peek, NOBIND_MAP_LIST0)(f, ud, peek, __VA_ARGS__)
+// Expands to f(ud, arg1), f(ud, arg2), ...
+#define NOBIND_MAP_LIST(f, ud, ...) NOBIND_EVAL(NOBIND_MAP_LIST1(f, ud, __VA_ARGS__, ()()(), ()()(), ()()(), 0))
+
+#define NOBIND_STRUCT_FIELD(STRUCT, FIELD) Nobind::MakeStructField(#FIELD, &STRUCT::FIELD)
+
+// Declare a struct that will be converted to and from plain JS objects
+// NOBIND_STRUCT(STRUCT, field1, field2, ...); must be used in the global namespace
+#define NOBIND_STRUCT(STRUCT, ...)                                                                                     \
+  namespace Nobind {                                                                                                   \
+  template <> struct StructFields<STRUCT> {                                                                            \
+    static constexpr auto fields = std::make_tuple(NOBIND_MAP_LIST(NOBIND_STRUCT_FIELD, STRUCT, __VA_ARGS__));         \
+  };                                                                                                                   \
+  namespace Typemap {                                                                                                  \
+  template <> class FromJS<STRUCT> : public FromJSStruct<STRUCT> {                                                     \
+  public:                                                                                                              \
+    using FromJSStruct<STRUCT>::FromJSStruct;                                                                          \
+  };                                                                                                                   \
+  template <> class FromJS<const STRUCT &> : public FromJSStruct<const STRUCT &> {                                     \
+  public:                                                                                                              \
+    using FromJSStruct<const STRUCT &>::FromJSStruct;                                                                  \
+  };                                                                                                                   \
+  template <const ReturnAttribute &RETATTR> class ToJS<STRUCT, RETATTR> : public ToJSStruct<STRUCT, RETATTR> {         \
+  public:                                                                                                              \
+    using ToJSStruct<STRUCT, RETATTR>::ToJSStruct;                                                                     \
+  };                                                                                                                   \
+  template <const ReturnAttribute &RETATTR>                                                                            \
+  class ToJS<STRUCT &, RETATTR> : public ToJSStruct<STRUCT &, RETATTR> {                                               \
+  public:                                                                                                              \
+    using ToJSStruct<STRUCT &, RETATTR>::ToJSStruct;                                                                   \
+  };                                                                                                                   \
+  template <const ReturnAttribute &RETATTR>                                                                            \
+  class ToJS<const STRUCT &, RETATTR> : public ToJSStruct<const STRUCT &, RETATTR> {                                   \
+  public:                                                                                                              \
+    using ToJSStruct<const STRUCT &, RETATTR>::ToJSStruct;                                                             \
+  };                                                                                                                   \
+  }                                                                                                                    \
+  }                                                                                                                    \
+  static_assert(true, "")
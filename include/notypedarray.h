@@ -0,0 +1,306 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <notypes.h>
+
+namespace Nobind {
+
+// The TypedArray element type that matches a C++ arithmetic type
+template <typename T> constexpr napi_typedarray_type TypedArrayTypeOf() {
+  static_assert(std::is_arithmetic_v<T>, "TypedArrays can contain only arithmetic types");
+  if constexpr (std::is_floating_point_v<T>) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Unsupported floating point type");
+    return sizeof(T) == 4 ? napi_float32_array : napi_float64_array;
+  } else if constexpr (std::is_signed_v<T>) {
+    switch (sizeof(T)) {
+    case 1:
+      return napi_int8_array;
+    case 2:
+      return napi_int16_array;
+    case 4:
+      return napi_int32_array;
+    default:
+      return napi_bigint64_array;
+    }
+  } else {
+    switch (sizeof(T)) {
+    case 1:
+      return napi_uint8_array;
+    case 2:
+      return napi_uint16_array;
+    case 4:
+      return napi_uint32_array;
+    default:
+      return napi_biguint64_array;
+    }
+  }
+}
+
+// The name of the TypedArray element type (used both by the error messages and by TypeScript)
+NOBIND_INLINE const std::string &TypedArrayName(napi_typedarray_type type) {
+  static const std::string names[] = {"Int8Array"s,    "Uint8Array"s,    "Uint8ClampedArray"s, "Int16Array"s,
+                                      "Uint16Array"s,  "Int32Array"s,    "Uint32Array"s,       "Float32Array"s,
+                                      "Float64Array"s, "BigInt64Array"s, "BigUint64Array"s};
+  static const std::string unknown = "TypedArray"s;
+  if (static_cast<size_t>(type) < sizeof(names) / sizeof(names[0]))
+    return names[type];
+  return unknown;
+}
+
+// A contiguous buffer exposed by a C++ object (the buffer protocol)
+// length is the number of elements of the view, shape and strides (in elements)
+// are optional and are exposed as read-only properties of the view
+template <typename T> struct BufferInfo {
+  T *data;
+  size_t length;
+  std::vector<size_t> shape = {};
+  std::vector<size_t> strides = {};
+};
+
+namespace Typemap {
+
+// When C++ returns a BufferInfo, JS receives a TypedArray view over the C++ memory,
+// ReturnNested keeps the C++ object alive as long as the view is alive,
+// a BufferInfo<const T> is returned as a copy
+template <typename T, const ReturnAttribute &RETATTR> class ToJSBufferInfo {
+  Napi::Env env_;
+  BufferInfo<T> val_;
+
+  NOBIND_INLINE Napi::Array ToJSSizes(const std::vector<size_t> &v) {
+    Napi::Array r = Napi::Array::New(env_, v.size());
+    for (size_t i = 0; i < v.size(); i++)
+      r.Set(static_cast<uint32_t>(i), Napi::Number::New(env_, static_cast<double>(v[i])));
+    return r;
+  }
+
+public:
+  NOBIND_INLINE explicit ToJSBufferInfo(Napi::Env env, BufferInfo<T> val) : env_(env), val_(std::move(val)) {}
+  NOBIND_INLINE Napi::Value Get() {
+    static_assert(RETATTR.isNested() || RETATTR.isShared(),
+                  "BufferInfo views must be returned with ReturnNested or ReturnShared");
+    using E = std::remove_cv_t<T>;
+    size_t bytes = val_.length * sizeof(E);
+    void *data = const_cast<E *>(val_.data);
+    napi_value buffer;
+    // JS cannot be given write access to const C++ memory, the view of a const buffer is a copy
+    if (std::is_const_v<T> || bytes == 0 ||
+        napi_create_external_arraybuffer(env_, data, bytes, nullptr, nullptr, &buffer) != napi_ok) {
+      // Some runtimes (ie Electron) do not allow external buffers, the view is a copy
+      void *copy;
+      if (napi_create_arraybuffer(env_, bytes, &copy, &buffer) != napi_ok) {
+        throw Napi::Error::New(env_, "Failed to create an ArrayBuffer");
+      }
+      if (bytes > 0)
+        memcpy(copy, val_.data, bytes);
+    }
+    napi_value view;
+    if (napi_create_typedarray(env_, TypedArrayTypeOf<E>(), val_.length, buffer, 0, &view) != napi_ok) {
+      throw Napi::Error::New(env_, "Failed to create a TypedArray");
+    }
+    Napi::Object r(env_, view);
+    if (!val_.shape.empty())
+      r.DefineProperty(Napi::PropertyDescriptor::Value("shape", ToJSSizes(val_.shape), napi_enumerable));
+    if (!val_.strides.empty())
+      r.DefineProperty(Napi::PropertyDescriptor::Value("strides", ToJSSizes(val_.strides), napi_enumerable));
+    return r;
+  }
+  ToJSBufferInfo(const ToJSBufferInfo &) = delete;
+  ToJSBufferInfo(ToJSBufferInfo &&) = default;
+
+  static std::string TSType() {
+    return TypedArrayName(TypedArrayTypeOf<std::remove_cv_t<T>>()) +
+           " & { readonly shape?: number[]; readonly strides?: number[]; }"s;
+  }
+};
+
+template <typename T, const ReturnAttribute &RETATTR>
+class ToJS<BufferInfo<T>, RETATTR> : public ToJSBufferInfo<T, RETATTR> {
+public:
+  using ToJSBufferInfo<T, RETATTR>::ToJSBufferInfo;
+};
+
+// C arrays and std::arrays of numbers returned by reference (ie class members)
+// are TypedArray views over the C++ memory
+template <typename T, size_t N, const ReturnAttribute &RETATTR>
+class ToJSArrayView : public ToJSBufferInfo<T, RETATTR> {
+public:
+  NOBIND_INLINE explicit ToJSArrayView(Napi::Env env, T *data) : ToJSBufferInfo<T, RETATTR>(env, {data, N}) {}
+
+  static const std::string &TSType() { return TypedArrayName(TypedArrayTypeOf<std::remove_cv_t<T>>()); }
+};
+
+template <typename T, size_t N, const ReturnAttribute &RETATTR>
+class ToJS<T (&)[N], RETATTR> : public ToJSArrayView<T, N, RETATTR> {
+public:
+  NOBIND_INLINE explicit ToJS(Napi::Env env, T (&val)[N]) : ToJSArrayView<T, N, RETATTR>(env, val) {}
+};
+
+// This one is used only for the TypeScript type of array members
+template <typename T, size_t N, const ReturnAttribute &RETATTR>
+class ToJS<T[N], RETATTR> : public ToJS<T (&)[N], RETATTR> {
+public:
+  using ToJS<T (&)[N], RETATTR>::ToJS;
+};
+
+template <typename T, size_t N, const ReturnAttribute &RETATTR>
+class ToJS<std::array<T, N> &, RETATTR> : public ToJSArrayView<T, N, RETATTR> {
+public:
+  NOBIND_INLINE explicit ToJS(Napi::Env env, std::array<T, N> &val) : ToJSArrayView<T, N, RETATTR>(env, val.data()) {}
+};
+
+template <typename T, size_t N, const ReturnAttribute &RETATTR>
+class ToJS<const std::array<T, N> &, RETATTR> : public ToJSArrayView<const T, N, RETATTR> {
+public:
+  NOBIND_INLINE explicit ToJS(Napi::Env env, const std::array<T, N> &val)
+      : ToJSArrayView<const T, N, RETATTR>(env, val.data()) {}
+};
+
+// std::arrays of numbers returned by value are copied to a new TypedArray
+template <typename T, size_t N, const ReturnAttribute &RETATTR> class ToJS<std::array<T, N>, RETATTR> {
+  Napi::Env env_;
+  std::array<T, N> val_;
+
+public:
+  NOBIND_INLINE explicit ToJS(Napi::Env env, const std::array<T, N> &val) : env_(env), val_(val) {}
+  NOBIND_INLINE Napi::Value Get() {
+    napi_value buffer, view;
+    void *data;
+    if (napi_create_arraybuffer(env_, N * sizeof(T), &data, &buffer) != napi_ok) {
+      throw Napi::Error::New(env_, "Failed to create an ArrayBuffer");
+    }
+    if (N > 0)
+      memcpy(data, val_.data(), N * sizeof(T));
+    if (napi_create_typedarray(env_, TypedArrayTypeOf<T>(), N, buffer, 0, &view) != napi_ok) {
+      throw Napi::Error::New(env_, "Failed to create a TypedArray");
+    }
+    return Napi::Value(env_, view);
+  }
+
+  static const std::string &TSType() { return TypedArrayName(TypedArrayTypeOf<T>()); }
+};
+
+// When calling C++ with a JS TypedArray, C++ receives a pointer
+// to the TypedArray data and its number of elements
+// The JS TypedArray object is protected from the GC for the
+// duration of the call
+template <typename T> class FromJSTypedArray {
+  T *data_;
+  size_t len_;
+  Napi::ObjectReference persistent;
+
+public:
+  NOBIND_INLINE explicit FromJSTypedArray(const Napi::Value &val) {
+    using E = std::remove_cv_t<T>;
+    constexpr napi_typedarray_type expected = TypedArrayTypeOf<E>();
+    if (!val.IsTypedArray()) {
+      throw Napi::TypeError::New(val.Env(), "Expected a "s + TypedArrayName(expected));
+    }
+    Napi::TypedArray array = val.As<Napi::TypedArray>();
+    napi_typedarray_type type = array.TypedArrayType();
+    if (type != expected && !(expected == napi_uint8_array && type == napi_uint8_clamped_array)) {
+      throw Napi::TypeError::New(val.Env(), "Expected a "s + TypedArrayName(expected) + ", got a "s +
+                                                TypedArrayName(type));
+    }
+    data_ = reinterpret_cast<T *>(static_cast<uint8_t *>(array.ArrayBuffer().Data()) + array.ByteOffset());
+    len_ = array.ElementLength();
+    persistent = Napi::Persistent(val.As<Napi::Object>());
+  }
+
+  template <size_t N> NOBIND_INLINE auto Get() {
+    static_assert(N < 2, "A TypedArray produces only a pointer and a length");
+    if constexpr (N == 0)
+      return data_;
+    else
+      return len_;
+  }
+
+  FromJSTypedArray(const FromJSTypedArray &) = delete;
+  NOBIND_INLINE FromJSTypedArray(FromJSTypedArray &&) = default;
+
+  static const std::string &TSType() { return TypedArrayName(TypedArrayTypeOf<std::remove_cv_t<T>>()); }
+};
+
+// (CTYPE *, size_t) and (const CTYPE *, size_t) are produced by a TypedArray of the matching type
+#define TYPEMAPS_FOR_TYPEDARRAY(CTYPE)                                                                                 \
+  template <> class FromJSMulti<CTYPE *, size_t> : public FromJSTypedArray<CTYPE> {                                    \
+  public:                                                                                                              \
+    using FromJSTypedArray<CTYPE>::FromJSTypedArray;                                                                   \
+  };                                                                                                                   \
+  template <> class FromJSMulti<const CTYPE *, size_t> : public FromJSTypedArray<const CTYPE> {                        \
+  public:                                                                                                              \
+    using FromJSTypedArray<const CTYPE>::FromJSTypedArray;                                                             \
+  };
+
+// char is not included because (const char *, size_t) is usually a string
+TYPEMAPS_FOR_TYPEDARRAY(signed char);
+TYPEMAPS_FOR_TYPEDARRAY(unsigned char);
+TYPEMAPS_FOR_TYPEDARRAY(short);
+TYPEMAPS_FOR_TYPEDARRAY(unsigned short);
+TYPEMAPS_FOR_TYPEDARRAY(int);
+TYPEMAPS_FOR_TYPEDARRAY(unsigned int);
+TYPEMAPS_FOR_TYPEDARRAY(long);
+TYPEMAPS_FOR_TYPEDARRAY(unsigned long);
+TYPEMAPS_FOR_TYPEDARRAY(long long);
+TYPEMAPS_FOR_TYPEDARRAY(unsigned long long);
+TYPEMAPS_FOR_TYPEDARRAY(float);
+TYPEMAPS_FOR_TYPEDARRAY(double);
+
+const std::string BinaryData_tstype = "ArrayBuffer | ArrayBufferView"s;
+
+// (void *, size_t) and (const void *, size_t) are produced by the raw bytes
+// of an ArrayBuffer, a TypedArray, a DataView or a Buffer
+template <typename T> class FromJSBinaryData {
+  T *data_;
+  size_t len_;
+  Napi::ObjectReference persistent;
+
+public:
+  NOBIND_INLINE explicit FromJSBinaryData(const Napi::Value &val) {
+    if (val.IsArrayBuffer()) {
+      Napi::ArrayBuffer ab = val.As<Napi::ArrayBuffer>();
+      data_ = ab.Data();
+      len_ = ab.ByteLength();
+    } else if (val.IsTypedArray()) {
+      Napi::TypedArray array = val.As<Napi::TypedArray>();
+      data_ = static_cast<uint8_t *>(array.ArrayBuffer().Data()) + array.ByteOffset();
+      len_ = array.ByteLength();
+    } else if (val.IsDataView()) {
+      Napi::DataView view = val.As<Napi::DataView>();
+      data_ = static_cast<uint8_t *>(view.ArrayBuffer().Data()) + view.ByteOffset();
+      len_ = view.ByteLength();
+    } else {
+      throw Napi::TypeError::New(val.Env(), "Expected an ArrayBuffer or an ArrayBufferView");
+    }
+    persistent = Napi::Persistent(val.As<Napi::Object>());
+  }
+
+  template <size_t N> NOBIND_INLINE auto Get() {
+    static_assert(N < 2, "Binary data produces only a pointer and a length");
+    if constexpr (N == 0)
+      return data_;
+    else
+      return len_;
+  }
+
+  FromJSBinaryData(const FromJSBinaryData &) = delete;
+  NOBIND_INLINE FromJSBinaryData(FromJSBinaryData &&) = default;
+
+  static const std::string &TSType() { return BinaryData_tstype; }
+};
+
+template <> class FromJSMulti<void *, size_t> : public FromJSBinaryData<void> {
+public:
+  using FromJSBinaryData<void>::FromJSBinaryData;
+};
+template <> class FromJSMulti<const void *, size_t> : public FromJSBinaryData<const void> {
+public:
+  using FromJSBinaryData<const void>::FromJSBinaryData;
+};
+
+} // namespace Typemap
+
+} // namespace Nobind
@@ -2,7 +2,9 @@
 #include <nodebug.h>
 #include <nonapi.h>
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 
@@ -10,6 +12,10 @@
 #define NOBIND_PARENT_PROP "__nobind_parent_reference"
 #endif
 
+#ifndef NOBIND_MIRROR_PROP
+#define NOBIND_MIRROR_PROP "__nobind_mirror"
+#endif
+
 using namespace std::literals::string_literals;
 
 #include <noattributes.h>
@@ -26,9 +32,37 @@ inline void CheckArgLength(Napi::Env env, size_t expected, size_t actual) {
 
 const std::string boolean_tstype = "boolean"s;
 
+// C++20 coroutines returning a Nobind::Task, specialized in nocoro.h
+template <typename T> struct IsTask : std::false_type {};
+
+// A coroutine outlives the call and the conversion buffers of its arguments,
+// it cannot receive references, pointers or string views
+template <typename T>
+constexpr bool IsBorrowedArg_v = std::is_reference_v<T> || std::is_pointer_v<T> ||
+                                 std::is_same_v<std::remove_cv_t<T>, std::string_view> ||
+                                 std::is_same_v<std::remove_cv_t<T>, std::u16string_view>;
+template <typename RETURN, typename... ARGS>
+constexpr bool CoroutineArgsByValue_v = !IsTask<RETURN>::value || (!IsBorrowedArg_v<ARGS> && ...);
+
 // https://stackoverflow.com/questions/22825512/get-type-of-member-memberpointer-points-to
 template <class C, typename T> T getMemberPointerType(T C::*v);
 
+// The same as a trait, it also works for array members
+template <typename M> struct MemberPointerType {};
+template <class C, typename T> struct MemberPointerType<T C::*> {
+  using type = T;
+};
+template <typename M> using MemberPointerType_t = typename MemberPointerType<M>::type;
+
+// Array members of numbers (other than char and bool) are exposed as TypedArray views
+template <typename T> constexpr bool IsTypedArrayElement_v =
+    std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool> && !std::is_same_v<std::remove_cv_t<T>, char>;
+template <typename T> struct IsTypedArrayMember : std::false_type {};
+template <typename T, size_t N> struct IsTypedArrayMember<T[N]> : std::bool_constant<IsTypedArrayElement_v<T>> {};
+template <typename T, size_t N>
+struct IsTypedArrayMember<std::array<T, N>> : std::bool_constant<IsTypedArrayElement_v<T>> {};
+template <typename T> constexpr bool IsTypedArrayMember_v = IsTypedArrayMember<std::remove_cv_t<T>>::value;
+
 namespace Typemap {
 
 // bool specializations
@@ -58,6 +92,34 @@ public:
   static const std::string &TSType() { return boolean_tstype; };
 };
 
+// Boolean conversion following the JS semantics, ie Boolean(val)
+template <> class FromJSCoerce<bool> {
+  bool val_;
+
+public:
+  NOBIND_INLINE explicit FromJSCoerce(const Napi::Value &val) { val_ = val.ToBoolean().Value(); }
+  NOBIND_INLINE bool Get() { return val_; }
+
+  static const std::string TSType() { return "unknown"s; };
+};
+
+// Boolean conversion with a single Node-API call, Node-API checks the type
+template <> class FromJSUnchecked<bool> {
+  bool val_;
+
+public:
+  NOBIND_INLINE explicit FromJSUnchecked(const Napi::Value &val) {
+    if (napi_get_value_bool(val.Env(), val, &val_) != napi_ok) {
+      throw Napi::TypeError::New(val.Env(), "Expected a boolean");
+    }
+  }
+  NOBIND_INLINE bool Get() { return val_; }
+  FromJSUnchecked(const FromJSUnchecked &) = delete;
+  FromJSUnchecked(FromJSUnchecked &&) = default;
+
+  static const std::string &TSType() { return boolean_tstype; };
+};
+
 // native specializations (does not support async)
 template <const ReturnAttribute &RETATTR> class ToJS<Napi::Value, RETATTR> {
   Napi::Env env_;
@@ -129,37 +191,346 @@ public:
   static constexpr bool unlock = test_Unlock<T>(int());
 };
 
+// Is T a typemap that can be constructed from JS values
+template <typename T>
+constexpr bool IsFromJSTypemap = std::is_constructible_v<T, const Napi::Value &> ||
+                                 std::is_constructible_v<T, const JSArgs &>;
+
+// Does the typemap TM support deferred conversion
+template <typename TM>
+constexpr bool IsFromJSDeferredTypemap = std::is_constructible_v<TM, const Napi::Value &, FromJSDeferred>;
+
+// Selects the typemap for T, the overrides have priority
+template <typename T> struct FromJSSelect {
+  using type = std::conditional_t<IsFromJSTypemap<TypemapOverrides::FromJS<T>>, TypemapOverrides::FromJS<T>,
+                                  Typemap::FromJS<T>>;
+};
+
+// Type getter for the typemap
+template <typename T> using FromJS_t = typename FromJSSelect<std::remove_cv_t<T>>::type;
+
 // Main entry point when processing a Napi::Value
 template <typename T> auto NOBIND_INLINE FromJSValue(const Napi::Value &val) {
-  if constexpr (std::is_constructible_v<TypemapOverrides::FromJS<std::remove_cv_t<T>>, const Napi::Value &>) {
-    return TypemapOverrides::FromJS<std::remove_cv_t<T>>(val);
+  // Construct in place to avoid copying
+  // (this type is potentially not copy-constructible)
+  return FromJS_t<T>(val);
+}
+
+// Construct a typemap from a JS value, in deferred mode if requested and supported
+template <typename TM, bool DEFERRED = false> NOBIND_INLINE TM FromJSTypemapValue(const Napi::Value &val) {
+  if constexpr (DEFERRED && IsFromJSDeferredTypemap<TM>) {
+    return TM(val, FromJSDeferred{});
   } else {
-    return Typemap::FromJS<std::remove_cv_t<T>>(val);
+    return TM(val);
   }
 }
 
-// Type getter for the above method
-template <typename T>
-using FromJS_t = typename std::invoke_result_t<decltype(Nobind::FromJSValue<std::remove_cv_t<T>>), const Napi::Value &>;
+// Number of JS arguments consumed by a typemap
+template <typename TM> constexpr size_t FromJSTypemapInputs() {
+  if constexpr (FromJSTypemapHasInputs<TM>::value) {
+    return TM::Inputs;
+  } else {
+    return 1;
+  }
+}
+
+// Construct a typemap from the arguments starting at idx and advance idx
+template <typename TM> NOBIND_INLINE TM FromJSTypemapArgs(const Napi::CallbackInfo &info, size_t &idx) {
+  size_t current_idx = idx;
+  idx += FromJSTypemapInputs<TM>();
+  if constexpr (FromJSTypemapInputs<TM>() > 1) {
+    return TM(JSArgs{info, current_idx, FromJSTypemapInputs<TM>()});
+  } else {
+    return TM(info[current_idx]);
+  }
+}
 
 // Main entry point when processing a value from arguments
 template <typename T> auto NOBIND_INLINE FromJSArgs(const Napi::CallbackInfo &info, size_t &idx) {
-  // Get the template specialization that will be used from the result of FromJSArgs for T
-  using FromJSTypeMap = FromJS_t<std::remove_cv_t<T>>;
+  return FromJSTypemapArgs<FromJS_t<T>>(info, idx);
+}
 
-  size_t current_idx = idx;
+#ifndef NOBIND_MAX_MULTI_ARGUMENTS
+#define NOBIND_MAX_MULTI_ARGUMENTS 4
+#endif
+
+template <size_t I, typename... ARGS> using ArgAt_t = std::tuple_element_t<I, std::tuple<ARGS...>>;
+
+// Selects the multi-argument typemap for T..., the overrides have priority
+template <typename... T> struct FromJSMultiSelect {
+  using type = std::conditional_t<IsFromJSTypemap<TypemapOverrides::FromJSMulti<std::remove_cv_t<T>...>>,
+                                  TypemapOverrides::FromJSMulti<std::remove_cv_t<T>...>,
+                                  Typemap::FromJSMulti<std::remove_cv_t<T>...>>;
+  static constexpr bool exists = IsFromJSTypemap<type>;
+};
+
+// The multi-argument typemap for ARGS[START]...ARGS[START + LEN - 1]
+template <size_t START, typename SEQ, typename... ARGS> struct FromJSMultiSlice;
+template <size_t START, size_t... K, typename... ARGS>
+struct FromJSMultiSlice<START, std::index_sequence<K...>, ARGS...> : FromJSMultiSelect<ArgAt_t<START + K, ARGS...>...> {
+};
+
+// Selects the multi-argument output typemap for T..., the overrides have priority
+template <typename... T> struct ToJSMultiSelect {
+  using overridden = TypemapOverrides::ToJSMulti<std::remove_cv_t<T>...>;
+  using type = std::conditional_t<std::is_constructible_v<overridden, Napi::Env>, overridden,
+                                  Typemap::ToJSMulti<std::remove_cv_t<T>...>>;
+  static constexpr bool exists = std::is_constructible_v<type, Napi::Env>;
+};
+
+// The multi-argument output typemap for ARGS[START]...ARGS[START + LEN - 1]
+template <size_t START, typename SEQ, typename... ARGS> struct ToJSMultiSlice;
+template <size_t START, size_t... K, typename... ARGS>
+struct ToJSMultiSlice<START, std::index_sequence<K...>, ARGS...> : ToJSMultiSelect<ArgAt_t<START + K, ARGS...>...> {};
+
+// The typemap of an output argument, T is a pointer or a non-const reference
+// to a value that is allocated for the duration of the call and then returned to JS
+template <typename T> class FromJSOutput {
+  static_assert(std::is_pointer_v<T> || std::is_lvalue_reference_v<T>,
+                "Output arguments must be pointers or non-const references");
+  using U = std::remove_pointer_t<std::remove_reference_t<T>>;
+  static_assert(!std::is_const_v<U>, "Output arguments cannot be const");
+  static_assert(std::is_default_constructible_v<U>, "Output arguments must be default constructible");
+
+  U val_;
+
+public:
+  using type = U;
+  static const size_t Inputs = 0;
+
+  NOBIND_INLINE explicit FromJSOutput(const Napi::Value &) : val_{} {}
+  NOBIND_INLINE T Get() {
+    if constexpr (std::is_pointer_v<T>)
+      return &val_;
+    else
+      return val_;
+  }
+  NOBIND_INLINE U &Value() { return val_; }
+
+  FromJSOutput(const FromJSOutput &) = delete;
+  NOBIND_INLINE FromJSOutput(FromJSOutput &&) = default;
+};
+
+// The typemap of a sequence of output arguments that produce a single JS value,
+// TM is a Typemap::ToJSMulti
+template <typename TM> class FromJSMultiOutput {
+  TM val_;
+
+public:
+  static const size_t Inputs = 0;
+
+  NOBIND_INLINE explicit FromJSMultiOutput(const Napi::Value &val) : val_(val.Env()) {}
+  template <size_t N> NOBIND_INLINE auto Get() { return val_.template Get<N>(); }
+  NOBIND_INLINE Napi::Value Result() { return val_.Get(); }
+
+  FromJSMultiOutput(const FromJSMultiOutput &) = delete;
+  NOBIND_INLINE FromJSMultiOutput(FromJSMultiOutput &&) = default;
+
+  static std::string TSType() { return TM::TSType(); }
+};
+
+// The argument layout of a function, it determines which C++ arguments
+// are produced by multi-argument typemaps
+// Span() is the number of C++ arguments produced by the typemap at each position:
+// * 1 for regular typemaps
+// * >1 for the first argument of a multi-argument typemap
+// * 0 for the remaining arguments of a multi-argument typemap
+// An output argument can start a multi-argument output typemap, it is never part
+// of a multi-argument input typemap
+template <const ArgumentAttribute &ARGATTR, typename... ARGS> class FromJSArgsLayout {
+  static constexpr size_t N = sizeof...(ARGS);
+
+  template <size_t START, size_t LEN> static constexpr bool HasMulti() {
+    if constexpr (LEN < 2 || START + LEN > N) {
+      return false;
+    } else if constexpr (ARGATTR.isOutput(START)) {
+      return ToJSMultiSlice<START, std::make_index_sequence<LEN>, ARGS...>::exists;
+    } else if constexpr (ARGATTR.hasOutput(START, LEN)) {
+      return false;
+    } else {
+      return FromJSMultiSlice<START, std::make_index_sequence<LEN>, ARGS...>::exists;
+    }
+  }
+
+  // The longest multi-argument typemap starting at START, 1 if there isn't one
+  template <size_t START, size_t LEN = NOBIND_MAX_MULTI_ARGUMENTS> static constexpr size_t Longest() {
+    if constexpr (LEN < 2) {
+      return 1;
+    } else if constexpr (HasMulti<START, LEN>()) {
+      return LEN;
+    } else {
+      return Longest<START, LEN - 1>();
+    }
+  }
+
+  template <size_t... I> static constexpr std::array<size_t, N> Spans(std::index_sequence<I...>) {
+    std::array<size_t, N> longest{Longest<I>()...};
+    std::array<size_t, N> spans{};
+    // Multi-argument typemaps are matched greedily left to right
+    size_t i = 0;
+    while (i < N) {
+      spans[i] = longest[i];
+      for (size_t k = 1; k < longest[i] && i + k < N; k++)
+        spans[i + k] = 0;
+      i += longest[i];
+    }
+    return spans;
+  }
+
+public:
+  static constexpr size_t Span(size_t i) { return Spans(std::index_sequence_for<ARGS...>{})[i]; }
+
+  // The position of the typemap that produces the argument at i
+  static constexpr size_t Head(size_t i) {
+    while (Span(i) == 0)
+      i--;
+    return i;
+  }
+
+  // Number of JS values produced by the output arguments
+  static constexpr size_t Outputs() {
+    size_t r = 0;
+    for (size_t i = 0; i < N; i++)
+      if (ARGATTR.isOutput(i) && Span(i) > 0)
+        r++;
+    return r;
+  }
+};
+
+// Placeholder for the arguments produced by a preceding multi-argument typemap
+class FromJSMultiFollower {
+public:
+  static const size_t Inputs = 0;
+};
+
+template <size_t I, size_t SPAN, const ArgumentAttribute &ARGATTR, typename... ARGS> struct FromJSArgSelect {
+  using type = std::conditional_t<
+      ARGATTR.isOutput(I),
+      FromJSMultiOutput<typename ToJSMultiSlice<I, std::make_index_sequence<SPAN>, ARGS...>::type>,
+      typename FromJSMultiSlice<I, std::make_index_sequence<SPAN>, ARGS...>::type>;
+};
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS> struct FromJSArgSelect<I, 1, ARGATTR, ARGS...> {
+  using T = ArgAt_t<I, ARGS...>;
+  using U = std::remove_cv_t<T>;
+  // The checking modes produce values, they apply equally to const references
+  using V = std::remove_cv_t<std::remove_reference_t<T>>;
+  // Overridden typemaps always have priority over the checking mode
+  static constexpr bool overridden = IsFromJSTypemap<TypemapOverrides::FromJS<U>>;
+  static constexpr bool coerce = !overridden && ARGATTR.isCoerce(I) && IsFromJSTypemap<Typemap::FromJSCoerce<V>>;
+  static constexpr bool unchecked =
+      !overridden && ARGATTR.isUnchecked(I) && IsFromJSTypemap<Typemap::FromJSUnchecked<V>>;
+  static constexpr bool latin1 = !overridden && ARGATTR.isLatin1(I) && IsFromJSTypemap<Typemap::FromJSLatin1<T>>;
+  static constexpr bool soa =
+      !overridden && ARGATTR.isStructOfArrays(I) && IsFromJSTypemap<Typemap::FromJSStructOfArrays<T>>;
+  using type = std::conditional_t<
+      ARGATTR.isOutput(I), FromJSOutput<T>,
+      std::conditional_t<
+          coerce, Typemap::FromJSCoerce<V>,
+          std::conditional_t<
+              unchecked, Typemap::FromJSUnchecked<V>,
+              std::conditional_t<latin1, Typemap::FromJSLatin1<T>,
+                                 std::conditional_t<soa, Typemap::FromJSStructOfArrays<T>, FromJS_t<T>>>>>>;
+};
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS> struct FromJSArgSelect<I, 0, ARGATTR, ARGS...> {
+  using type = FromJSMultiFollower;
+};
+
+// Type getter for the typemap at position I
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS>
+using FromJSArg_t =
+    typename FromJSArgSelect<I, FromJSArgsLayout<ARGATTR, ARGS...>::Span(I), ARGATTR, ARGS...>::type;
+
+template <typename SEQ, const ArgumentAttribute &ARGATTR, typename... ARGS> struct FromJSArgsSelect;
+template <size_t... I, const ArgumentAttribute &ARGATTR, typename... ARGS>
+struct FromJSArgsSelect<std::index_sequence<I...>, ARGATTR, ARGS...> {
+  using type = std::tuple<FromJSArg_t<I, ARGATTR, ARGS...>...>;
+  static constexpr size_t inputs = (0 + ... + FromJSTypemapInputs<FromJSArg_t<I, ARGATTR, ARGS...>>());
+};
+
+// Type getter for the tuple of all typemaps of a function
+template <const ArgumentAttribute &ARGATTR, typename... ARGS>
+using FromJSArgs_t = typename FromJSArgsSelect<std::index_sequence_for<ARGS...>, ARGATTR, ARGS...>::type;
 
-  // Check if this template specialization has Inputs
-  if constexpr (FromJSTypemapHasInputs<FromJSTypeMap>::value) {
-    static_assert(FromJSTypeMap::Inputs == 0 || FromJSTypeMap::Inputs == 1,
-                  "Only 1:1 and 1:0 conversions are supported at the moment");
-    idx += FromJSTypeMap::Inputs;
+// Number of JS arguments expected by a function
+template <const ArgumentAttribute &ARGATTR, typename... ARGS>
+constexpr size_t FromJSArgsInputs = FromJSArgsSelect<std::index_sequence_for<ARGS...>, ARGATTR, ARGS...>::inputs;
+
+// Construct the typemap at position I
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS>
+NOBIND_INLINE FromJSArg_t<I, ARGATTR, ARGS...> FromJSArg(const Napi::CallbackInfo &info, size_t &idx) {
+  if constexpr (FromJSArgsLayout<ARGATTR, ARGS...>::Span(I) == 0) {
+    return FromJSMultiFollower{};
   } else {
-    idx++;
+    return FromJSTypemapArgs<FromJSArg_t<I, ARGATTR, ARGS...>>(info, idx);
+  }
+}
+
+// Construct all the typemaps of a function
+// Alas, std::forward_as_tuple does not guarantee
+// the evaluation order of its arguments, only *braced-init-list* lists do
+// https://en.cppreference.com/w/cpp/language/list_initialization
+template <const ArgumentAttribute &ARGATTR, typename... ARGS, size_t... I>
+NOBIND_INLINE FromJSArgs_t<ARGATTR, ARGS...> FromJSArgsAll(const Napi::CallbackInfo &info, size_t &idx,
+                                                           std::index_sequence<I...>) {
+  return FromJSArgs_t<ARGATTR, ARGS...>{FromJSArg<I, ARGATTR, ARGS...>(info, idx)...};
+}
+
+// Is the typemap at position I constructed in deferred mode in async calls
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS> constexpr bool IsFromJSArgDeferred() {
+  using TM = FromJSArg_t<I, ARGATTR, ARGS...>;
+  return FromJSArgsLayout<ARGATTR, ARGS...>::Span(I) == 1 && FromJSTypemapInputs<TM>() == 1 &&
+         IsFromJSDeferredTypemap<TM>;
+}
+
+// Construct the typemap at position I for an async call, in deferred mode if supported
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS>
+NOBIND_INLINE FromJSArg_t<I, ARGATTR, ARGS...> FromJSArgDeferred(const Napi::CallbackInfo &info, size_t &idx) {
+  using TM = FromJSArg_t<I, ARGATTR, ARGS...>;
+  if constexpr (IsFromJSArgDeferred<I, ARGATTR, ARGS...>()) {
+    return FromJSTypemapValue<TM, true>(info[idx++]);
+  } else {
+    return FromJSArg<I, ARGATTR, ARGS...>(info, idx);
+  }
+}
+
+// Construct all the typemaps of an async call
+template <const ArgumentAttribute &ARGATTR, typename... ARGS, size_t... I>
+NOBIND_INLINE FromJSArgs_t<ARGATTR, ARGS...> FromJSArgsAllDeferred(const Napi::CallbackInfo &info, size_t &idx,
+                                                                   std::index_sequence<I...>) {
+  return FromJSArgs_t<ARGATTR, ARGS...>{FromJSArgDeferred<I, ARGATTR, ARGS...>(info, idx)...};
+}
+
+// Does a deferred typemap report if its conversion is still pending
+template <typename TM, typename = void> struct HasFromJSDeferredState : std::false_type {};
+template <typename TM>
+struct HasFromJSDeferredState<TM, std::void_t<decltype(std::declval<const TM &>().Deferred())>> : std::true_type {};
+
+// Is the conversion of any argument of an async call still pending, calling Get() on the
+// main thread would perform it there (typemaps that do not report it are always pending)
+template <const ArgumentAttribute &ARGATTR, typename... ARGS, typename TUPLE, size_t... I>
+NOBIND_INLINE bool FromJSArgsPending(const TUPLE &args, std::index_sequence<I...>) {
+  auto pending = [](const auto &tm, auto deferred) -> bool {
+    using TM = std::remove_cv_t<std::remove_reference_t<decltype(tm)>>;
+    if constexpr (!decltype(deferred)::value) {
+      return false;
+    } else if constexpr (HasFromJSDeferredState<TM>::value) {
+      return tm.Deferred();
+    } else {
+      return true;
+    }
+  };
+  return (pending(std::get<I>(args), std::bool_constant<IsFromJSArgDeferred<I, ARGATTR, ARGS...>()>{}) || ...);
+}
+
+// Retrieve the C++ argument at position I from the tuple of typemaps
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS, typename TUPLE>
+NOBIND_INLINE decltype(auto) FromJSArgGet(TUPLE &args) {
+  if constexpr (FromJSArgsLayout<ARGATTR, ARGS...>::Span(I) == 1) {
+    return std::get<I>(args).Get();
+  } else {
+    constexpr size_t head = FromJSArgsLayout<ARGATTR, ARGS...>::Head(I);
+    return std::get<head>(args).template Get<I - head>();
   }
-  // Construct in place to avoid copying
-  // (this type is potentially not copy-constructible)
-  return FromJSValue<std::remove_cv_t<T>>(info[current_idx]);
 }
 
 // Main entry point when generating a Napi::Value
@@ -178,25 +549,81 @@ template <typename T, const ReturnAttribute &RETATTR>
 using ToJS_t =
     typename std::invoke_result_t<decltype(Nobind::ToJS<never_void_t<T>, RETATTR>), const Napi::Env &, never_void_t<T>>;
 
+// Convert the output argument at position I, an empty value for the other arguments
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS, typename TUPLE>
+NOBIND_INLINE Napi::Value ToJSOutputArg(const Napi::Env &env, TUPLE &args) {
+  constexpr size_t span = FromJSArgsLayout<ARGATTR, ARGS...>::Span(I);
+  if constexpr (ARGATTR.isOutput(I) && span > 1) {
+    return std::get<I>(args).Result();
+  } else if constexpr (ARGATTR.isOutput(I) && span == 1) {
+    using U = typename std::tuple_element_t<I, TUPLE>::type;
+    return ToJS_t<U, ReturnDefault>(env, std::get<I>(args).Value()).Get();
+  } else {
+    return Napi::Value();
+  }
+}
+
+// Construct the JS result of a function from its returned value and its output arguments:
+// * the returned value if there are no output arguments
+// * the output argument if the function returns void and has a single output argument
+// * an array with the returned value (unless void) followed by the output arguments otherwise
+template <const ArgumentAttribute &ARGATTR, bool RETURNS, typename... ARGS, typename TUPLE, size_t... I>
+NOBIND_INLINE Napi::Value ToJSResults(const Napi::Env &env, Napi::Value result, TUPLE &args,
+                                      std::index_sequence<I...>) {
+  constexpr size_t outputs = FromJSArgsLayout<ARGATTR, ARGS...>::Outputs();
+  if constexpr (outputs == 0) {
+    return result;
+  } else {
+    std::array<Napi::Value, sizeof...(I)> values{ToJSOutputArg<I, ARGATTR, ARGS...>(env, args)...};
+    if constexpr (!RETURNS && outputs == 1) {
+      for (auto &v : values)
+        if (!v.IsEmpty())
+          return v;
+    }
+    Napi::Array array = Napi::Array::New(env, outputs + (RETURNS ? 1 : 0));
+    uint32_t j = 0;
+    if constexpr (RETURNS)
+      array.Set(j++, result);
+    for (auto &v : values)
+      if (!v.IsEmpty())
+        array.Set(j++, v);
+    return array;
+  }
+}
+
 #ifndef NOBIND_NO_ASYNC_LOCKING
-// A RAII guard that calls FromJS::Lock()/Unlock() if the typemap has them
-template <typename T> class FromJSLockGuard {
-  FromJS_t<T> &tm_;
+// A RAII guard that calls Lock()/Unlock() if the typemap has them
+template <typename TM> class FromJSTypemapLockGuard {
+  TM &tm_;
 
 public:
-  FromJSLockGuard(FromJS_t<T> &tm) : tm_(tm) {
-    if constexpr (FromJSTypemapHasLocking<FromJS_t<T>>::lock) {
+  FromJSTypemapLockGuard(TM &tm) : tm_(tm) {
+    if constexpr (FromJSTypemapHasLocking<TM>::lock) {
       tm_.Lock();
     }
   };
-  virtual ~FromJSLockGuard() {
-    if constexpr (FromJSTypemapHasLocking<FromJS_t<T>>::unlock) {
+  virtual ~FromJSTypemapLockGuard() {
+    if constexpr (FromJSTypemapHasLocking<TM>::unlock) {
       tm_.Unlock();
     }
   }
 
-  FromJSLockGuard(const FromJSLockGuard &) = delete;
+  FromJSTypemapLockGuard(const FromJSTypemapLockGuard &) = delete;
 };
+
+// The same guard using the C++ type
+template <typename T> using FromJSLockGuard = FromJSTypemapLockGuard<FromJS_t<T>>;
+
+template <typename SEQ, const ArgumentAttribute &ARGATTR, typename... ARGS> struct FromJSArgsLockGuardsSelect;
+template <size_t... I, const ArgumentAttribute &ARGATTR, typename... ARGS>
+struct FromJSArgsLockGuardsSelect<std::index_sequence<I...>, ARGATTR, ARGS...> {
+  using type = std::tuple<FromJSTypemapLockGuard<FromJSArg_t<I, ARGATTR, ARGS...>>...>;
+};
+
+// Type getter for the tuple of the lock guards of all typemaps of a function
+template <const ArgumentAttribute &ARGATTR, typename... ARGS>
+using FromJSArgsLockGuards_t =
+    typename FromJSArgsLockGuardsSelect<std::index_sequence_for<ARGS...>, ARGATTR, ARGS...>::type;
 #endif
 
 } // namespace Nobind
@@ -5,6 +5,7 @@
 
 #include <noattributes.h>
 #include <nonapi.h>
+#include <notypedarray.h>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -67,11 +68,13 @@ template <typename T, const ReturnAttribute &RETATTR> std::string ToTSType() {
       return TSTYPE_DEBUG("unknown"s, T);
     }
   } else {
-    if constexpr (JSTypemapHasTSType<Typemap::ToJS<std::remove_cv_t<T>>>::value) {
+    // The TS type of the built-in typemaps can depend on the return attributes
+    using TM = Typemap::ToJS<std::remove_cv_t<T>, RETATTR>;
+    if constexpr (JSTypemapHasTSType<TM>::value) {
       if constexpr (RETATTR.isReturnNullAccept()) {
-        return TSTYPE_DEBUG(Typemap::ToJS<std::remove_cv_t<T>>::TSType() + " | null", T);
+        return TSTYPE_DEBUG(TM::TSType() + " | null", T);
       } else {
-        return TSTYPE_DEBUG(Typemap::ToJS<std::remove_cv_t<T>>::TSType(), T);
+        return TSTYPE_DEBUG(TM::TSType(), T);
       }
     } else {
       return TSTYPE_DEBUG("unknown"s, T);
@@ -79,13 +82,108 @@ template <typename T, const ReturnAttribute &RETATTR> std::string ToTSType() {
   }
 }
 
+// Resolve the C++ argument at position I to TS argument types
+// (multi-argument typemaps produce one TS argument for the whole sequence
+// while typemaps with multiple inputs produce one TS argument per input)
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS> std::vector<std::string> FromTSArgType() {
+  constexpr size_t span = FromJSArgsLayout<ARGATTR, ARGS...>::Span(I);
+  using T = ArgAt_t<I, ARGS...>;
+  if constexpr (span == 0) {
+    return {};
+  } else if constexpr (FromJSTypemapInputs<FromJSArg_t<I, ARGATTR, ARGS...>>() == 0) {
+    return {};
+  } else {
+    using TM = FromJSArg_t<I, ARGATTR, ARGS...>;
+    std::string type;
+    if constexpr (span == 1 && std::is_same_v<TM, FromJS_t<T>>) {
+      type = FromTSType<T>();
+    } else if constexpr (JSTypemapHasTSType<TM>::value) {
+      type = TSTYPE_DEBUG(TM::TSType(), T);
+    } else {
+      type = TSTYPE_DEBUG("unknown"s, T);
+    }
+    return std::vector<std::string>(FromJSTypemapInputs<TM>(), type);
+  }
+}
+
 // Construct a string with all function argument
-template <typename... ARGS> NOBIND_INLINE std::string FromTSTypes() {
-  std::vector<std::string> types{FromTSType<ARGS>()...};
+template <const ArgumentAttribute &ARGATTR, typename... ARGS, size_t... I>
+NOBIND_INLINE std::string FromTSTypes(std::index_sequence<I...>) {
+  std::vector<std::vector<std::string>> types{FromTSArgType<I, ARGATTR, ARGS...>()...};
+  std::string types_text;
+  for (size_t i = 0; i < types.size(); i++) {
+    for (size_t k = 0; k < types[i].size(); k++) {
+      if (types[i][k].empty())
+        continue;
+      if (!types_text.empty())
+        types_text += ", "s;
+      types_text += "arg"s + std::to_string(i);
+      if (types[i].size() > 1)
+        types_text += "_"s + std::to_string(k);
+      types_text += ": "s + types[i][k];
+    }
+  }
+  return types_text;
+}
+template <const ArgumentAttribute &ARGATTR, typename... ARGS> NOBIND_INLINE std::string FromTSTypes() {
+  return FromTSTypes<ARGATTR, ARGS...>(std::index_sequence_for<ARGS...>{});
+}
+
+// Resolve the output argument at position I to a TS type, empty for the other arguments
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS> std::string ToTSOutputType() {
+  constexpr size_t span = FromJSArgsLayout<ARGATTR, ARGS...>::Span(I);
+  if constexpr (ARGATTR.isOutput(I) && span > 1) {
+    return FromJSArg_t<I, ARGATTR, ARGS...>::TSType();
+  } else if constexpr (ARGATTR.isOutput(I) && span == 1) {
+    return ToTSType<typename FromJSOutput<ArgAt_t<I, ARGS...>>::type, ReturnDefault>();
+  } else {
+    return ""s;
+  }
+}
+
+// Construct the TS type of the result of a function (refer to ToJSResults in notypes.h)
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          size_t... I>
+NOBIND_INLINE std::string ToTSResults(std::index_sequence<I...>) {
+  std::string return_text = ToTSType<RETURN, RETATTR>();
+  if constexpr (FromJSArgsLayout<ARGATTR, ARGS...>::Outputs() > 0) {
+    std::vector<std::string> types;
+    if constexpr (!std::is_void_v<RETURN>)
+      types.push_back(return_text);
+    for (auto &t : std::vector<std::string>{ToTSOutputType<I, ARGATTR, ARGS...>()...}) {
+      if (!t.empty())
+        types.push_back(t);
+    }
+    if (types.size() == 1) {
+      return_text = types[0];
+    } else {
+      return_text = "["s;
+      for (size_t i = 0; i < types.size(); i++)
+        return_text += (i > 0 ? ", "s : ""s) + types[i];
+      return_text += "]"s;
+    }
+  }
+  if constexpr (RETATTR.isAsync())
+    return "Promise<"s + return_text + ">"s;
+  else
+    return return_text;
+}
+
+// Batch calls receive arrays of their arguments, numbers can also be passed as TypedArrays
+template <size_t I, const ArgumentAttribute &ARGATTR, typename... ARGS> std::string FromTSBatchArgType() {
+  using U = std::remove_cv_t<std::remove_reference_t<ArgAt_t<I, ARGS...>>>;
+  std::string type = "("s + FromTSArgType<I, ARGATTR, ARGS...>()[0] + ")[]"s;
+  if constexpr (IsTypedArrayElement_v<U>)
+    return TypedArrayName(TypedArrayTypeOf<U>()) + " | "s + type;
+  else
+    return type;
+}
+
+template <const ArgumentAttribute &ARGATTR, typename... ARGS, size_t... I>
+NOBIND_INLINE std::string FromTSBatchTypes(std::index_sequence<I...>) {
+  std::vector<std::string> types{FromTSBatchArgType<I, ARGATTR, ARGS...>()...};
   std::string types_text;
   for (size_t i = 0; i < types.size(); i++) {
-    if (types[i].empty())
-      continue;
     if (!types_text.empty())
       types_text += ", "s;
     types_text += "arg"s + std::to_string(i) + ": "s + types[i];
@@ -93,6 +191,38 @@ template <typename... ARGS> NOBIND_INLINE std::string FromTSTypes() {
   return types_text;
 }
 
+// Batch calls return a TypedArray for numbers and an array otherwise
+// (parallel batch calls return a Promise)
+template <const ReturnAttribute &RETATTR, typename RETURN> std::string ToTSBatchResult() {
+  using R = std::remove_cv_t<RETURN>;
+  std::string return_text;
+  if constexpr (std::is_void_v<R>)
+    return_text = "void"s;
+  else if constexpr (IsTypedArrayElement_v<R>)
+    return_text = TypedArrayName(TypedArrayTypeOf<R>());
+  else
+    return_text = "("s + ToTSType<RETURN, RETATTR>() + ")[]"s;
+  if constexpr (RETATTR.isParallel())
+    return "Promise<"s + return_text + ">"s;
+  else
+    return return_text;
+}
+
+// The argument and return types of a function
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS>
+NOBIND_INLINE std::string SignatureTypes() {
+  if constexpr (RETATTR.isBatch() || RETATTR.isParallel()) {
+    return "("s + FromTSBatchTypes<ARGATTR, ARGS...>(std::index_sequence_for<ARGS...>{}) + "): "s +
+           ToTSBatchResult<RETATTR, RETURN>();
+  } else {
+    std::string args_text = FromTSTypes<ARGATTR, ARGS...>();
+    if constexpr (RETATTR.isCancellable())
+      args_text += (args_text.empty() ? ""s : ", "s) + "signal?: AbortSignal"s;
+    return "("s + args_text + "): "s +
+           ToTSResults<RETATTR, ARGATTR, RETURN, ARGS...>(std::index_sequence_for<ARGS...>{});
+  }
+}
+
 // Construct a string with all implements arguments
 template <typename... INTERFACES> NOBIND_INLINE std::string FromTSTInterfaces() {
   std::vector<std::string> types{FromTSType<INTERFACES>()...};
@@ -110,122 +240,119 @@ template <typename... INTERFACES> NOBIND_INLINE std::string FromTSTInterfaces()
 // FunctionSignature is a three-stage function (refer to the comments in nofunction.h)
 // It constructs TypeScript signatures for global function ands static class members
 // Third stage
-template <const ReturnAttribute &RETATTR, auto *FUNC, typename RETURN, typename... ARGS, std::size_t... I,
-          typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, auto *FUNC, typename RETURN,
+          typename... ARGS, std::size_t... I, typename NAME = const char *>
 NOBIND_INLINE std::string FunctionSignature(NAME name, const char *prefix, std::index_sequence<I...>) {
-  std::string types_text = FromTSTypes<ARGS...>();
-  std::string return_text;
+  std::string signature_text = SignatureTypes<RETATTR, ARGATTR, RETURN, ARGS...>();
   std::string resolved_name;
   if constexpr (std::is_same_v<Napi::Symbol, NAME>) {
     resolved_name = "["s + ((Napi::Symbol)name).ToObject().Get("description").ToString().Utf8Value() + "]"s;
   } else {
     resolved_name = std::string{name};
   }
-  if constexpr (RETATTR.isAsync())
-    return_text = "Promise<"s + ToTSType<RETURN, RETATTR>() + ">"s;
-  else
-    return_text = ToTSType<RETURN, RETATTR>();
-  return std::string{prefix} + resolved_name + "("s + types_text + "): "s + return_text + ";\n"s;
+  return std::string{prefix} + resolved_name + signature_text + ";\n"s;
 }
 
 // Second stage, two variants (except and noexcept)
-template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(ARGS...),
-          typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...), typename NAME = const char *>
 NOBIND_INLINE std::string FunctionSignature(NAME name, const char *prefix,
                                             std::integral_constant<RETURN (*)(ARGS...), FUNC>) {
-  return FunctionSignature<RETATTR, FUNC, RETURN, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
+  return FunctionSignature<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
 }
-template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(ARGS...) noexcept,
-          typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(ARGS...) noexcept, typename NAME = const char *>
 NOBIND_INLINE std::string FunctionSignature(NAME name, const char *prefix,
                                             std::integral_constant<RETURN (*)(ARGS...) noexcept, FUNC>) {
-  return FunctionSignature<RETATTR, FUNC, RETURN, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
+  return FunctionSignature<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
 }
 
 // First stage
-template <const ReturnAttribute &RETATTR, auto *FUNC, typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, auto *FUNC, const ArgumentAttribute &ARGATTR = ArgumentDefault,
+          typename NAME = const char *>
 std::string FunctionSignature(NAME name, const char *prefix) {
-  return FunctionSignature<RETATTR>(name, prefix, std::integral_constant<decltype(FUNC), FUNC>{});
+  return FunctionSignature<RETATTR, ARGATTR>(name, prefix, std::integral_constant<decltype(FUNC), FUNC>{});
 }
 
 // Class extension, second stages, call the FunctionSignature 3rd stage
 // Variant 1, This() is CLASS & or const CLASS &
-template <const ReturnAttribute &RETATTR, typename RETURN, typename CLASS, typename... ARGS,
-          RETURN (*FUNC)(CLASS &, ARGS...), typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename CLASS,
+          typename... ARGS, RETURN (*FUNC)(CLASS &, ARGS...), typename NAME = const char *>
 NOBIND_INLINE std::string ExtensionSignature(NAME name, const char *prefix,
                                              std::integral_constant<RETURN (*)(CLASS &, ARGS...), FUNC>) {
-  return FunctionSignature<RETATTR, FUNC, RETURN, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
+  return FunctionSignature<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
 }
 // Variant 2, This() is Napi::Value
-template <const ReturnAttribute &RETATTR, typename RETURN, typename... ARGS, RETURN (*FUNC)(Napi::Value, ARGS...),
-          typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename RETURN, typename... ARGS,
+          RETURN (*FUNC)(Napi::Value, ARGS...), typename NAME = const char *>
 NOBIND_INLINE std::string ExtensionSignature(NAME name, const char *prefix,
                                              std::integral_constant<RETURN (*)(Napi::Value, ARGS...), FUNC>) {
-  return FunctionSignature<RETATTR, FUNC, RETURN, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
+  return FunctionSignature<RETATTR, ARGATTR, FUNC, RETURN, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
 }
 // Class extension, first stage
-template <const ReturnAttribute &RETATTR, auto *FUNC, typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, auto *FUNC, const ArgumentAttribute &ARGATTR = ArgumentDefault,
+          typename NAME = const char *>
 std::string ExtensionSignature(NAME name, const char *prefix) {
-  return ExtensionSignature<RETATTR>(name, prefix, std::integral_constant<decltype(FUNC), FUNC>{});
+  return ExtensionSignature<RETATTR, ARGATTR>(name, prefix, std::integral_constant<decltype(FUNC), FUNC>{});
 }
 
 // Construct a TypeScript signature for a class constructor
 template <typename... ARGS> std::string ConstructorSignature() {
-  std::string types_text = FromTSTypes<ARGS...>();
+  std::string types_text = FromTSTypes<ArgumentDefault, ARGS...>();
   return "constructor("s + types_text + ");\n"s;
 }
 
 // Member function, 3 stages
 // Third stage
-template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, auto FUNC, typename... ARGS, std::size_t... I,
-          typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN, auto FUNC,
+          typename... ARGS, std::size_t... I, typename NAME = const char *>
 NOBIND_INLINE std::string MethodSignature(NAME name, const char *prefix, std::index_sequence<I...>) {
-  std::string types_text = FromTSTypes<ARGS...>();
-  std::string return_text;
+  std::string signature_text = SignatureTypes<RETATTR, ARGATTR, RETURN, ARGS...>();
   std::string resolved_name;
   if constexpr (std::is_same_v<Napi::Symbol, NAME>) {
     resolved_name = "["s + ((Napi::Symbol)name).ToObject().Get("description").ToString().Utf8Value() + "]"s;
   } else {
     resolved_name = std::string{name};
   }
-  if constexpr (RETATTR.isAsync())
-    return_text = "Promise<"s + ToTSType<RETURN, RETATTR>() + ">"s;
-  else
-    return_text = ToTSType<RETURN, RETATTR>();
-  return std::string{prefix} + resolved_name + "("s + types_text + "): "s + return_text + ";\n"s;
+  return std::string{prefix} + resolved_name + signature_text + ";\n"s;
 }
 
 // Second stage, 4 variants:
 // - regular, const, noexcept and const noexcept
-template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-          RETURN (BASE::*FUNC)(ARGS...), typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+          typename... ARGS, RETURN (BASE::*FUNC)(ARGS...), typename NAME = const char *>
 NOBIND_INLINE std::string MethodSignature(NAME name, const char *prefix,
                                           std::integral_constant<RETURN (BASE::*)(ARGS...), FUNC>) {
-  return MethodSignature<RETATTR, BASE, RETURN, FUNC, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
+  return MethodSignature<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(name, prefix,
+                                                                        std::index_sequence_for<ARGS...>{});
 }
-template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-          RETURN (BASE::*FUNC)(ARGS...) const, typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+          typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) const, typename NAME = const char *>
 NOBIND_INLINE std::string MethodSignature(NAME name, const char *prefix,
                                           std::integral_constant<RETURN (BASE::*)(ARGS...) const, FUNC>) {
-  return MethodSignature<RETATTR, BASE, RETURN, FUNC, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
+  return MethodSignature<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(name, prefix,
+                                                                        std::index_sequence_for<ARGS...>{});
 }
-template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-          RETURN (BASE::*FUNC)(ARGS...) noexcept, typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+          typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) noexcept, typename NAME = const char *>
 NOBIND_INLINE std::string MethodSignature(NAME name, const char *prefix,
                                           std::integral_constant<RETURN (BASE::*)(ARGS...) noexcept, FUNC>) {
-  return MethodSignature<RETATTR, BASE, RETURN, FUNC, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
+  return MethodSignature<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(name, prefix,
+                                                                        std::index_sequence_for<ARGS...>{});
 }
-template <const ReturnAttribute &RETATTR, typename BASE, typename RETURN, typename... ARGS,
-          RETURN (BASE::*FUNC)(ARGS...) const noexcept, typename NAME = const char *>
+template <const ReturnAttribute &RETATTR, const ArgumentAttribute &ARGATTR, typename BASE, typename RETURN,
+          typename... ARGS, RETURN (BASE::*FUNC)(ARGS...) const noexcept, typename NAME = const char *>
 NOBIND_INLINE std::string MethodSignature(NAME name, const char *prefix,
                                           std::integral_constant<RETURN (BASE::*)(ARGS...) const noexcept, FUNC>) {
-  return MethodSignature<RETATTR, BASE, RETURN, FUNC, ARGS...>(name, prefix, std::index_sequence_for<ARGS...>{});
+  return MethodSignature<RETATTR, ARGATTR, BASE, RETURN, FUNC, ARGS...>(name, prefix,
+                                                                        std::index_sequence_for<ARGS...>{});
 }
 
 // First stage
-template <const ReturnAttribute &RET, auto FUNC, typename NAME = const char *>
+template <const ReturnAttribute &RET, auto FUNC, const ArgumentAttribute &ARGATTR = ArgumentDefault,
+          typename NAME = const char *>
 std::string MethodSignature(NAME name, const char *prefix) {
-  return MethodSignature<RET>(name, prefix, std::integral_constant<decltype(FUNC), FUNC>{});
+  return MethodSignature<RET, ARGATTR>(name, prefix, std::integral_constant<decltype(FUNC), FUNC>{});
 }
 
 // Class property
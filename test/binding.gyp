@@ -1,6 +1,7 @@
 {
   'variables': {
     'enable_asan%': 'false',
+    'cxx_std%': 'c++17',
     'test_output%': '<(test)'
   },
   'targets': [
@@ -29,17 +30,17 @@
     'includes': [ '../except.gypi' ],
     'cflags': [
       '-fvisibility=hidden',
-      '-std=c++17'
+      '-std=<(cxx_std)'
     ],
     'msvs_settings': {
       'VCCLCompilerTool': { 
-        'AdditionalOptions': [ '/std:c++17', '/permissive-' ]
+        'AdditionalOptions': [ '/std:<(cxx_std)', '/permissive-', '/Zc:preprocessor' ]
       }
     },
     'xcode_settings': {
       'OTHER_CPLUSPLUSFLAGS': [
         '-fvisibility=hidden',
-        '-std=c++17'
+        '-std=<(cxx_std)'
       ]
     },
     'conditions': [
@@ -0,0 +1,25 @@
+#include "adaptive.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+int32_t quick(int32_t a, int32_t b) { return a + b; }
+
+int32_t slow(int32_t a) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  return a * a;
+}
+
+int32_t picky(int32_t a) {
+  if (a < 0)
+    throw std::invalid_argument{"negative"};
+  return a;
+}
+
+Counter::Counter() : value_(0) {}
+
+int32_t Counter::increment(int32_t step) {
+  value_ += step;
+  return value_;
+}
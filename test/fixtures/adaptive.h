@@ -0,0 +1,14 @@
+#include <cstdint>
+#include <string>
+
+int32_t quick(int32_t a, int32_t b);
+int32_t slow(int32_t a);
+int32_t picky(int32_t a);
+
+class Counter {
+  int32_t value_;
+
+public:
+  Counter();
+  int32_t increment(int32_t step);
+};
@@ -0,0 +1,26 @@
+#include "arg_transforms.h"
+
+// Returns the sum of the elements of an array
+double sum_f64(const double *data, size_t len) {
+  double sum = 0;
+  for (size_t i = 0; i < len; i++)
+    sum += data[i];
+  return sum;
+}
+
+// Multiplies in place the elements of an array
+void scale_i32(int32_t *data, size_t len, int32_t factor) {
+  for (size_t i = 0; i < len; i++)
+    data[i] *= factor;
+}
+
+// Returns the sum of all bytes in a memory region
+uint32_t byte_sum(const void *data, size_t len) {
+  auto *bytes = static_cast<const uint8_t *>(data);
+  uint32_t sum = 0;
+  for (size_t i = 0; i < len; i++)
+    sum += bytes[i];
+  return sum;
+}
+
+int range_length(Range r) { return r.last - r.first; }
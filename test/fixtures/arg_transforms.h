@@ -0,0 +1,13 @@
+#include <cstddef>
+#include <cstdint>
+
+double sum_f64(const double *, size_t);
+void scale_i32(int32_t *, size_t, int32_t);
+uint32_t byte_sum(const void *, size_t);
+
+struct Range {
+  int first;
+  int last;
+};
+
+int range_length(Range);
@@ -0,0 +1,19 @@
+#include "array_members.h"
+
+Transform::Transform() : matrix{}, position{0, 0, 0}, flags{0, 0} {
+  for (int i = 0; i < 4; i++)
+    matrix[i * 4 + i] = 1;
+}
+
+float Transform::trace() const {
+  float r = 0;
+  for (int i = 0; i < 4; i++)
+    r += matrix[i * 4 + i];
+  return r;
+}
+
+double Transform::x() const { return position[0]; }
+
+std::array<double, 3> Transform::scaled(double factor) const {
+  return {position[0] * factor, position[1] * factor, position[2] * factor};
+}
@@ -0,0 +1,14 @@
+#include <array>
+#include <cstdint>
+
+class Transform {
+public:
+  float matrix[16];
+  std::array<double, 3> position;
+  int32_t flags[2];
+
+  Transform();
+  float trace() const;
+  double x() const;
+  std::array<double, 3> scaled(double factor) const;
+};
@@ -0,0 +1,28 @@
+#include "batch.h"
+
+#include <stdexcept>
+
+static double accumulated = 0;
+
+double add(double a, double b) { return a + b; }
+
+int32_t scale(int32_t v, int32_t factor) {
+  if (factor == 0)
+    throw std::invalid_argument{"factor cannot be zero"};
+  return v * factor;
+}
+
+bool positive(double v) { return v > 0; }
+
+std::string greet(const std::string &name) { return "Hello " + name; }
+
+void accumulate(double v) { accumulated += v; }
+
+double total() { return accumulated; }
+
+Accumulator::Accumulator() : sum(0) {}
+
+double Accumulator::add(double v) {
+  sum += v;
+  return sum;
+}
@@ -0,0 +1,17 @@
+#include <cstdint>
+#include <string>
+
+double add(double a, double b);
+int32_t scale(int32_t v, int32_t factor);
+bool positive(double v);
+std::string greet(const std::string &name);
+void accumulate(double v);
+double total();
+
+class Accumulator {
+public:
+  double sum;
+
+  Accumulator();
+  double add(double v);
+};
@@ -0,0 +1,42 @@
+#include "buffer_protocol.h"
+#include <stdexcept>
+
+Image::Image(size_t w, size_t h, size_t ch) : pixels_(w * h * ch), width(w), height(h), channels(ch) {
+  for (size_t i = 0; i < pixels_.size(); i++)
+    pixels_[i] = static_cast<uint8_t>(i);
+}
+
+unsigned Image::get(size_t x, size_t y, size_t c) const {
+  if (x >= width || y >= height || c >= channels)
+    throw std::range_error{"Out of bounds"};
+  return pixels_[(y * width + x) * channels + c];
+}
+
+void Image::set(size_t x, size_t y, size_t c, unsigned v) {
+  if (x >= width || y >= height || c >= channels)
+    throw std::range_error{"Out of bounds"};
+  pixels_[(y * width + x) * channels + c] = static_cast<uint8_t>(v);
+}
+
+uint8_t *Image::data() { return pixels_.data(); }
+
+const uint8_t *Image::data() const { return pixels_.data(); }
+
+size_t Image::size() const { return pixels_.size(); }
+
+Matrix::Matrix(size_t r, size_t c) : data_(r * c, 0.f), rows(r), cols(c) {}
+
+float Matrix::get(size_t r, size_t c) const {
+  if (r >= rows || c >= cols)
+    throw std::range_error{"Out of bounds"};
+  return data_[r * cols + c];
+}
+
+float *Matrix::data() { return data_.data(); }
+
+float Matrix::sum() const {
+  float r = 0;
+  for (auto v : data_)
+    r += v;
+  return r;
+}
@@ -0,0 +1,27 @@
+#include <cstdint>
+#include <stdlib.h>
+#include <vector>
+
+class Image {
+  std::vector<uint8_t> pixels_;
+
+public:
+  const size_t width, height, channels;
+  Image(size_t width, size_t height, size_t channels);
+  unsigned get(size_t x, size_t y, size_t c) const;
+  void set(size_t x, size_t y, size_t c, unsigned v);
+  uint8_t *data();
+  const uint8_t *data() const;
+  size_t size() const;
+};
+
+class Matrix {
+  std::vector<float> data_;
+
+public:
+  const size_t rows, cols;
+  Matrix(size_t rows, size_t cols);
+  float get(size_t r, size_t c) const;
+  float *data();
+  float sum() const;
+};
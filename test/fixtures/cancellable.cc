@@ -0,0 +1,21 @@
+#include "cancellable.h"
+
+#include <chrono>
+#include <thread>
+
+std::atomic<int32_t> cancellable_runs{0};
+
+int32_t sleeper(int32_t ms) {
+  cancellable_runs++;
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  return ms;
+}
+
+// Returns the number of elapsed milliseconds
+int32_t spinner(int32_t ms, const std::function<bool()> &stop) {
+  cancellable_runs++;
+  int32_t i;
+  for (i = 0; i < ms && !stop(); i++)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return i;
+}
@@ -0,0 +1,8 @@
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+extern std::atomic<int32_t> cancellable_runs;
+
+int32_t sleeper(int32_t ms);
+int32_t spinner(int32_t ms, const std::function<bool()> &stop);
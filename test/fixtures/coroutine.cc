@@ -0,0 +1,15 @@
+#include "coroutine.h"
+
+#include <chrono>
+#include <thread>
+
+static std::thread::id main_thread;
+
+void remember_main_thread() { main_thread = std::this_thread::get_id(); }
+
+bool on_main_thread() { return std::this_thread::get_id() == main_thread; }
+
+int32_t slow_square(int32_t v) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  return v * v;
+}
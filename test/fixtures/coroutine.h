@@ -0,0 +1,5 @@
+#include <cstdint>
+
+void remember_main_thread();
+bool on_main_thread();
+int32_t slow_square(int32_t v);
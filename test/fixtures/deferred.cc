@@ -0,0 +1,29 @@
+#include "deferred.h"
+
+static bool deferred = false;
+
+std::string echo(const std::string &s) { return s; }
+
+std::string join(const std::vector<std::string> &v, const std::string &sep) {
+  std::string r;
+  for (size_t i = 0; i < v.size(); i++) {
+    if (i > 0)
+      r += sep;
+    r += v[i];
+  }
+  return r;
+}
+
+std::string concat_values(const std::map<std::string, std::string> &m) {
+  std::string r;
+  for (auto const &el : m)
+    r += el.first + "=" + el.second + ";";
+  return r;
+}
+
+int32_t word_count(const Words &w) {
+  deferred = w.deferred;
+  return static_cast<int32_t>(w.list.size());
+}
+
+bool last_deferred() { return deferred; }
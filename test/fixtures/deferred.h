@@ -0,0 +1,17 @@
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+std::string echo(const std::string &s);
+std::string join(const std::vector<std::string> &v, const std::string &sep);
+std::string concat_values(const std::map<std::string, std::string> &m);
+
+// Parsed from a JS string by a custom typemap
+struct Words {
+  std::vector<std::string> list;
+  bool deferred;
+};
+
+int32_t word_count(const Words &w);
+bool last_deferred();
@@ -0,0 +1,43 @@
+#include "future.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+std::future<int32_t> future_value(int32_t v, int32_t ms) {
+  return std::async(std::launch::async, [v, ms]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    return v;
+  });
+}
+
+std::future<void> future_void(int32_t ms) {
+  return std::async(std::launch::async, [ms]() { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); });
+}
+
+std::future<std::string> future_promise(const std::string &v, int32_t ms) {
+  std::promise<std::string> promise;
+  auto future = promise.get_future();
+  std::thread([promise = std::move(promise), v, ms]() mutable {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    promise.set_value(v);
+  }).detach();
+  return future;
+}
+
+std::future<std::string> future_throws(const std::string &msg) {
+  std::promise<std::string> promise;
+  promise.set_exception(std::make_exception_ptr(std::runtime_error(msg)));
+  return promise.get_future();
+}
+
+std::future<int32_t> future_deferred(int32_t v) {
+  return std::async(std::launch::deferred, [v]() { return v * 2; });
+}
+
+std::future<int32_t> future_invalid() { return std::future<int32_t>{}; }
+
+std::shared_future<std::string> future_shared() {
+  static std::shared_future<std::string> shared = future_promise("shared", 10).share();
+  return shared;
+}
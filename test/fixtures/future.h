@@ -0,0 +1,12 @@
+#include <cstdint>
+#include <future>
+#include <string>
+
+std::future<int32_t> future_value(int32_t v, int32_t ms);
+std::future<void> future_void(int32_t ms);
+// Completed by a std::promise from another thread
+std::future<std::string> future_promise(const std::string &v, int32_t ms);
+std::future<std::string> future_throws(const std::string &msg);
+std::future<int32_t> future_deferred(int32_t v);
+std::future<int32_t> future_invalid();
+std::shared_future<std::string> future_shared();
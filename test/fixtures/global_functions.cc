@@ -2,6 +2,8 @@
 
 int add(int a, int b) { return a + b; }
 
+int addRef(const int &a, const int &b) { return a + b; }
+
 bool gte(int a, int b) { return a >= b; }
 
 int testa(bool a) { return a ? 1 : 0; }
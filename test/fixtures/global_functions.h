@@ -2,6 +2,7 @@
 #include <sstream>
 
 int add(int a, int b);
+int addRef(const int &a, const int &b);
 bool gte(int a, int b);
 double power(double a, double b);
 std::string hello(const std::string &s);
@@ -0,0 +1,15 @@
+#include "inflight.h"
+
+#include <chrono>
+#include <thread>
+
+int32_t delayed(int32_t v) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  return v;
+}
+
+int32_t delayed_reject(int32_t v) { return delayed(v); }
+
+int32_t delayed_drop(int32_t v) { return delayed(v); }
+
+int32_t Worker::work(int32_t v) { return delayed(v) * 2; }
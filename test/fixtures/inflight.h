@@ -0,0 +1,10 @@
+#include <cstdint>
+
+int32_t delayed(int32_t v);
+int32_t delayed_reject(int32_t v);
+int32_t delayed_drop(int32_t v);
+
+class Worker {
+public:
+  int32_t work(int32_t v);
+};
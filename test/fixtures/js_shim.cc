@@ -0,0 +1,13 @@
+#include "js_shim.h"
+#include <cmath>
+
+double hypot3(double a, double b, double c) { return std::sqrt(a * a + b * b + c * c); }
+
+int scale(int value, bool twice) { return twice ? value * 2 : value; }
+
+std::string greet(const std::string &name) { return "Hello, " + name; }
+
+void split(double value, int &integral, double &fractional) {
+  integral = static_cast<int>(value);
+  fractional = value - integral;
+}
@@ -0,0 +1,6 @@
+#include <string>
+
+double hypot3(double a, double b, double c);
+int scale(int value, bool twice);
+std::string greet(const std::string &name);
+void split(double value, int &integral, double &fractional);
@@ -0,0 +1,36 @@
+#include "memoized.h"
+
+#include <cmath>
+#include <stdexcept>
+
+int32_t memoized_calls = 0;
+
+double distance(double lat1, double lon1, double lat2, double lon2) {
+  memoized_calls++;
+  constexpr double rad = 3.14159265358979323846 / 180;
+  double dlat = (lat2 - lat1) * rad;
+  double dlon = (lon2 - lon1) * rad;
+  double a = std::sin(dlat / 2) * std::sin(dlat / 2) +
+             std::cos(lat1 * rad) * std::cos(lat2 * rad) * std::sin(dlon / 2) * std::sin(dlon / 2);
+  return 6371 * 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+}
+
+std::string greeting(const std::string &name, int32_t times) {
+  memoized_calls++;
+  std::string r;
+  for (int32_t i = 0; i < times; i++)
+    r += "Hello " + name + "! ";
+  return r;
+}
+
+int32_t checked_length(const std::string &s) {
+  memoized_calls++;
+  if (s.empty())
+    throw std::invalid_argument{"empty"};
+  return static_cast<int32_t>(s.size());
+}
+
+double Geodesy::degrees(double radians) {
+  memoized_calls++;
+  return radians * 180 / 3.14159265358979323846;
+}
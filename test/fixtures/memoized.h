@@ -0,0 +1,12 @@
+#include <cstdint>
+#include <string>
+
+extern int32_t memoized_calls;
+
+double distance(double lat1, double lon1, double lat2, double lon2);
+std::string greeting(const std::string &name, int32_t times);
+int32_t checked_length(const std::string &s);
+
+struct Geodesy {
+  static double degrees(double radians);
+};
@@ -0,0 +1,24 @@
+#include "mirrored_class.h"
+
+Particle::Particle() : x(0), y(0), mass(1), charge(0), id(0), active(false) {}
+
+Particle::Particle(double _x, double _y) : x(_x), y(_y), mass(1), charge(0), id(0), active(true) {}
+
+double Particle::energy() const { return mass * (x * x + y * y) / 2; }
+
+void Particle::move(double dx, double dy) {
+  x += dx;
+  y += dy;
+}
+
+Ion::Ion(double _x, double _y, int32_t _electrons) : Particle(_x, _y), electrons(_electrons) {
+  charge = -electrons;
+}
+
+Particle collide(const Particle &a, const Particle &b) {
+  Particle r{(a.x + b.x) / 2, (a.y + b.y) / 2};
+  r.mass = a.mass + b.mass;
+  r.charge = a.charge + b.charge;
+  r.id = a.id + b.id;
+  return r;
+}
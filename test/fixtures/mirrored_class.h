@@ -0,0 +1,24 @@
+#include <cstdint>
+
+class Particle {
+public:
+  double x, y;
+  float mass;
+  int32_t charge;
+  uint64_t id;
+  bool active;
+
+  Particle();
+  Particle(double x, double y);
+  double energy() const;
+  void move(double dx, double dy);
+};
+
+class Ion : public Particle {
+public:
+  int32_t electrons;
+
+  Ion(double x, double y, int32_t electrons);
+};
+
+Particle collide(const Particle &a, const Particle &b);
@@ -0,0 +1,35 @@
+#include "output_args.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+void polar_to_cartesian(double r, double theta, double *x, double *y) {
+  *x = r * std::cos(theta);
+  *y = r * std::sin(theta);
+}
+
+bool parse_int(const std::string &s, int &out) {
+  char *end;
+  long v = std::strtol(s.c_str(), &end, 10);
+  if (s.empty() || *end != '\0')
+    return false;
+  out = static_cast<int>(v);
+  return true;
+}
+
+void library_name(std::string &name) { name = "nobind17"; }
+
+int repeat_bytes(const std::string &s, int times, char **out, size_t *outlen) {
+  *outlen = s.size() * times;
+  *out = static_cast<char *>(std::malloc(*outlen + 1));
+  for (int i = 0; i < times; i++)
+    std::memcpy(*out + i * s.size(), s.data(), s.size());
+  return times;
+}
+
+Accumulator::Accumulator() : total_(0) {}
+
+void Accumulator::add(int v, int *total) {
+  total_ += v;
+  *total = total_;
+}
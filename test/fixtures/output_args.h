@@ -0,0 +1,15 @@
+#include <string>
+
+void polar_to_cartesian(double r, double theta, double *x, double *y);
+bool parse_int(const std::string &s, int &out);
+void library_name(std::string &name);
+// C-style output buffer allocated with malloc()
+int repeat_bytes(const std::string &s, int times, char **out, size_t *outlen);
+
+class Accumulator {
+  int total_;
+
+public:
+  Accumulator();
+  void add(int v, int *total);
+};
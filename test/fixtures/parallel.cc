@@ -0,0 +1,27 @@
+#include "parallel.h"
+
+#include <cmath>
+#include <stdexcept>
+
+uint32_t collatz(uint32_t n) {
+  uint32_t steps = 0;
+  uint64_t v = n;
+  while (v > 1) {
+    v = v % 2 ? 3 * v + 1 : v / 2;
+    steps++;
+  }
+  return steps;
+}
+
+double checked_sqrt(double v) {
+  if (v < 0)
+    throw std::domain_error{"negative value"};
+  return std::sqrt(v);
+}
+
+std::string repeat(const std::string &s, int32_t n) {
+  std::string r;
+  for (int32_t i = 0; i < n; i++)
+    r += s;
+  return r;
+}
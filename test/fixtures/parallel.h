@@ -0,0 +1,6 @@
+#include <cstdint>
+#include <string>
+
+uint32_t collatz(uint32_t n);
+double checked_sqrt(double v);
+std::string repeat(const std::string &s, int32_t n);
@@ -0,0 +1,22 @@
+#include "priority.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+static std::mutex order_lock;
+static std::vector<int32_t> order;
+
+int32_t lane_task(int32_t id, int32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  std::lock_guard<std::mutex> guard{order_lock};
+  order.push_back(id);
+  return id;
+}
+
+std::vector<int32_t> lane_order() {
+  std::lock_guard<std::mutex> guard{order_lock};
+  std::vector<int32_t> r;
+  std::swap(r, order);
+  return r;
+}
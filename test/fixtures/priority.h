@@ -0,0 +1,6 @@
+#include <cstdint>
+#include <vector>
+
+// Sleeps for ms milliseconds and records the id in the completion order
+int32_t lane_task(int32_t id, int32_t ms);
+std::vector<int32_t> lane_order();
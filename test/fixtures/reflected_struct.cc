@@ -0,0 +1,42 @@
+#include "reflected_struct.h"
+#include <cmath>
+
+double distance(const Point &a, const Point &b) { return std::hypot(a.x - b.x, a.y - b.y); }
+
+Point midpoint(Point a, Point b) { return {(a.x + b.x) / 2, (a.y + b.y) / 2}; }
+
+Creature grow(Creature c) {
+  c.eyes++;
+  c.fangs = true;
+  c.position.x++;
+  return c;
+}
+
+const Point &origin() {
+  static const Point origin{0, 0};
+  return origin;
+}
+
+std::vector<Point> make_points(size_t n) {
+  std::vector<Point> r(n);
+  for (size_t i = 0; i < n; i++) {
+    r[i].x = static_cast<double>(i);
+    r[i].y = static_cast<double>(i) * 2;
+  }
+  return r;
+}
+
+double sum_x(const std::vector<Point> &points) {
+  double r = 0;
+  for (const auto &p : points)
+    r += p.x;
+  return r;
+}
+
+std::vector<Sample> scale_samples(std::vector<Sample> samples, double factor) {
+  for (auto &s : samples) {
+    s.value *= factor;
+    s.count++;
+  }
+  return samples;
+}
@@ -0,0 +1,29 @@
+#include <string>
+#include <vector>
+
+struct Point {
+  double x;
+  double y;
+};
+
+struct Creature {
+  std::string name;
+  unsigned eyes;
+  bool fangs;
+  Point position;
+};
+
+double distance(const Point &a, const Point &b);
+Point midpoint(Point a, Point b);
+Creature grow(Creature c);
+const Point &origin();
+
+struct Sample {
+  double value;
+  int count;
+  unsigned char flags;
+};
+
+std::vector<Point> make_points(size_t n);
+double sum_x(const std::vector<Point> &points);
+std::vector<Sample> scale_samples(std::vector<Sample> samples, double factor);
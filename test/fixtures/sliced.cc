@@ -0,0 +1,22 @@
+#include "sliced.h"
+
+std::vector<int32_t> sequence(int32_t n) {
+  std::vector<int32_t> r;
+  for (int32_t i = 0; i < n; i++)
+    r.push_back(i);
+  return r;
+}
+
+std::vector<std::string> labels(int32_t n) {
+  std::vector<std::string> r;
+  for (int32_t i = 0; i < n; i++)
+    r.push_back("label" + std::to_string(i));
+  return r;
+}
+
+std::vector<std::vector<int32_t>> triangle(int32_t n) {
+  std::vector<std::vector<int32_t>> r;
+  for (int32_t i = 0; i < n; i++)
+    r.push_back(sequence(i));
+  return r;
+}
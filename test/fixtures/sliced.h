@@ -0,0 +1,7 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+std::vector<int32_t> sequence(int32_t n);
+std::vector<std::string> labels(int32_t n);
+std::vector<std::vector<int32_t>> triangle(int32_t n);
@@ -0,0 +1,40 @@
+#include "strings.h"
+#include <cctype>
+
+size_t byte_length(std::string_view s) { return s.size(); }
+
+std::string_view first_word(std::string_view s) { return s.substr(0, s.find(' ')); }
+
+std::string join(const char *a, const char *b) { return std::string(a) + b; }
+
+char *to_upper(char *s) {
+  for (char *p = s; *p; p++)
+    *p = static_cast<char>(std::toupper(static_cast<unsigned char>(*p)));
+  return s;
+}
+
+std::string echo(const std::string &s) { return s; }
+
+size_t u16_length(const std::u16string &s) { return s.size(); }
+
+std::u16string u16_reverse(std::u16string_view s) { return std::u16string(s.rbegin(), s.rend()); }
+
+const char16_t *u16_hello() { return u"h\u00e9llo w\u00f6rld"; }
+
+const char *description() {
+  return "nobind17 is a library for creating Node.js addons from C++ code with very little boilerplate";
+}
+
+const char *description_utf8() { return "nobind17 est une biblioth\xc3\xa8que pour cr\xc3\xa9\x65r des addons Node.js"; }
+
+const std::string &schema() {
+  static const std::string schema(4096, 'x');
+  return schema;
+}
+
+const char *color_name(int color) {
+  static const char *names[] = {"red", "green", "blue"};
+  return names[color % 3];
+}
+
+std::string number_name(int n) { return "number " + std::to_string(n); }
@@ -0,0 +1,20 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+size_t byte_length(std::string_view s);
+std::string_view first_word(std::string_view s);
+std::string join(const char *a, const char *b);
+char *to_upper(char *s);
+std::string echo(const std::string &s);
+
+size_t u16_length(const std::u16string &s);
+std::u16string u16_reverse(std::u16string_view s);
+const char16_t *u16_hello();
+
+const char *description();
+const char *description_utf8();
+const std::string &schema();
+
+const char *color_name(int color);
+std::string number_name(int n);
@@ -35,6 +35,8 @@ function configure(test, stdio, opts, output) {
     while (include = match.exec(source)) {
       fixtures.push(include[1]);
     }
+    // Tests can require a newer C++ standard
+    const std = /NOBIND_TEST_STD\s+(c\+\+\d+)/.exec(source);
     if (test_basic_fiinalizers) {
       opts = ['--enable_require_basic_finalizers', ...(opts || [])];
     }
@@ -43,6 +45,7 @@ function configure(test, stdio, opts, output) {
       'configure',
       ...(opts || []),
       `--test=${test}`,
+      `--cxx_std=${std ? std[1] : 'c++17'}`,
       `--test_output=${output ?? test}`,
       `"--fixtures=${fixtures.map((f) => `fixtures/${f}.cc`).join(' ')}"`
     ], { stdio: stdio || 'pipe', cwd: __dirname, env, shell: true });
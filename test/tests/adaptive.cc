@@ -0,0 +1,10 @@
+#include <fixtures/adaptive.h>
+
+#include <nobind.h>
+
+NOBIND_MODULE(adaptive, m) {
+  m.def<&quick, Nobind::ReturnAdaptive>("quick")
+      .def<&slow, Nobind::ReturnAdaptive>("slow")
+      .def<&picky, Nobind::ReturnAdaptive>("picky");
+  m.def<Counter>("Counter").cons<>().def<&Counter::increment, Nobind::ReturnAdaptive>("increment");
+}
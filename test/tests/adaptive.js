@@ -0,0 +1,50 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('adaptive sync/async dispatch', () => {
+  it('the first call is offloaded', () => {
+    assert.strictEqual(dll.__adaptive().quick.samples, 0);
+    return dll.quick(2, 3).then((r) => {
+      assert.strictEqual(r, 5);
+      const stats = dll.__adaptive().quick;
+      assert.strictEqual(stats.offloaded, 1);
+      assert.strictEqual(stats.samples, 1);
+    });
+  });
+
+  it('quick calls run inline and return settled Promises', async () => {
+    for (let i = 0; i < 10; i++) assert.strictEqual(await dll.quick(i, 1), i + 1);
+    const stats = dll.__adaptive().quick;
+    assert.isAbove(stats.inline, 0);
+    assert.isBelow(stats.estimate, 50);
+    const p = dll.quick(1, 1);
+    assert.instanceOf(p, Promise);
+    return assert.becomes(p, 2);
+  });
+
+  it('slow calls stay in the thread pool', async () => {
+    for (let i = 0; i < 5; i++) assert.strictEqual(await dll.slow(i), i * i);
+    const stats = dll.__adaptive().slow;
+    assert.strictEqual(stats.inline, 0);
+    assert.strictEqual(stats.offloaded, 5);
+    assert.isAbove(stats.estimate, 1000);
+  });
+
+  it('exceptions reject the Promise in both modes', async () => {
+    await assert.isRejected(dll.picky(-1), /negative/);
+    for (let i = 0; i < 5; i++) assert.strictEqual(await dll.picky(i), i);
+    await assert.isRejected(dll.picky(-1), /negative/);
+    assert.isAbove(dll.__adaptive().picky.inline, 0);
+  });
+
+  it('class methods', async () => {
+    const c = new dll.Counter();
+    for (let i = 1; i <= 5; i++) assert.strictEqual(await c.increment(1), i);
+    const stats = dll.__adaptive()['Counter.increment'];
+    assert.strictEqual(stats.inline + stats.offloaded, 5);
+  });
+
+  it('invalid arguments reject', () => assert.isRejected(dll.quick('a', 1), /Expected a number/));
+});
@@ -0,0 +1,14 @@
+#include <fixtures/global_functions.h>
+
+#include <nobind.h>
+
+NOBIND_MODULE(arg_checking, m) {
+  m.def<&add>("add");
+  m.def<&add, Nobind::ReturnDefault, Nobind::ArgCoerce<0, 1>>("addCoerce");
+  m.def<&add, Nobind::ReturnDefault, Nobind::ArgUnchecked<0, 1>>("addUnchecked");
+  m.def<&addRef, Nobind::ReturnDefault, Nobind::ArgCoerce<0, 1>>("addRefCoerce");
+  m.def<&addRef, Nobind::ReturnDefault, Nobind::ArgUnchecked<0, 1>>("addRefUnchecked");
+  m.def<&power, Nobind::ReturnDefault, Nobind::ArgUnchecked<0, 1>>("powerUnchecked");
+  m.def<&testa, Nobind::ReturnDefault, Nobind::ArgCoerce<0>>("testaCoerce");
+  m.def<&testa, Nobind::ReturnDefault, Nobind::ArgUnchecked<0>>("testaUnchecked");
+}
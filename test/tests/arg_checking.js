@@ -0,0 +1,60 @@
+const { assert } = require('chai');
+
+describe('strict checking', () => {
+  it('nominal', () => {
+    assert.strictEqual(dll.add(2, 3), 5);
+  });
+
+  it('exception', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.add('2', 3);
+    }, /Expected a number/);
+  });
+});
+
+describe('coercing', () => {
+  it('numbers', () => {
+    assert.strictEqual(dll.addCoerce(2, 3), 5);
+    assert.strictEqual(dll.addCoerce('2', true), 3);
+    assert.strictEqual(dll.addCoerce(null, undefined), 0);
+  });
+
+  it('const references', () => {
+    assert.strictEqual(dll.addRefCoerce('2', true), 3);
+  });
+
+  it('booleans', () => {
+    assert.strictEqual(dll.testaCoerce(true), 1);
+    assert.strictEqual(dll.testaCoerce('a'), 1);
+    assert.strictEqual(dll.testaCoerce(0), 0);
+    assert.strictEqual(dll.testaCoerce({}), 1);
+  });
+});
+
+describe('unchecked', () => {
+  it('numbers', () => {
+    assert.strictEqual(dll.addUnchecked(2, 3), 5);
+    assert.strictEqual(dll.powerUnchecked(2, 0.5), Math.SQRT2);
+  });
+
+  it('const references', () => {
+    assert.strictEqual(dll.addRefUnchecked(2, 3), 5);
+  });
+
+  it('booleans', () => {
+    assert.strictEqual(dll.testaUnchecked(true), 1);
+    assert.strictEqual(dll.testaUnchecked(false), 0);
+  });
+
+  it('wrong types are still rejected by Node-API', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.addUnchecked('2', 3);
+    }, /Expected a number/);
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.testaUnchecked(1);
+    }, /Expected a boolean/);
+  });
+});
@@ -0,0 +1,37 @@
+#include <fixtures/arg_transforms.h>
+#include <fixtures/buffer.h>
+
+#include <nooverrides.h>
+
+namespace Nobind {
+namespace Typemap {
+// A typemap that consumes two JS arguments to produce one C++ argument
+template <> class FromJS<Range> {
+  Range val_;
+
+public:
+  static const size_t Inputs = 2;
+
+  inline explicit FromJS(const JSArgs &args) {
+    if (!args[0].IsNumber() || !args[1].IsNumber()) {
+      throw Napi::TypeError::New(args.Env(), "Expected two numbers");
+    }
+    val_ = {args[0].ToNumber().Int32Value(), args[1].ToNumber().Int32Value()};
+  }
+  inline Range Get() { return val_; }
+
+  static const std::string TSType() { return "number"; };
+};
+} // namespace Typemap
+} // namespace Nobind
+
+#include <nobind.h>
+
+NOBIND_MODULE(arg_transforms, m) {
+  m.def<&sum_f64>("sum");
+  m.def<&sum_f64, Nobind::ReturnAsync>("sumAsync");
+  m.def<&scale_i32>("scale");
+  m.def<&byte_sum>("byteSum");
+  m.def<&put_buffer>("putBuffer");
+  m.def<&range_length>("rangeLength");
+}
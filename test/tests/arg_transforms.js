@@ -0,0 +1,93 @@
+const { assert } = require('chai');
+
+describe('TypedArray to (pointer, length)', () => {
+  it('const pointer', () => {
+    const r = dll.sum(new Float64Array([1, 2, 3.5]));
+    assert.strictEqual(r, 6.5);
+  });
+
+  it('empty array', () => {
+    assert.strictEqual(dll.sum(new Float64Array([])), 0);
+  });
+
+  it('async', () => dll.sumAsync(new Float64Array([1, 2, 3.5]))
+    .then((r) => {
+      assert.strictEqual(r, 6.5);
+    }));
+
+  it('in-place modification without copying', () => {
+    const array = new Int32Array([1, -2, 3]);
+    dll.scale(array, 2);
+    assert.deepStrictEqual(array, new Int32Array([2, -4, 6]));
+  });
+
+  it('subarray', () => {
+    const array = new Int32Array([1, 2, 3, 4]);
+    dll.scale(array.subarray(1, 3), 10);
+    assert.deepStrictEqual(array, new Int32Array([1, 20, 30, 4]));
+  });
+
+  it('Buffer', () => {
+    const buf = Buffer.from(new Uint32Array([0x17, 0x17, 0x17, 0x17]).buffer);
+    dll.putBuffer(buf, 0x17);
+    assert.throws(() => {
+      dll.putBuffer(buf, 0x11);
+    }, /Invalid value/);
+  });
+
+  it('wrong TypedArray type', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.sum(new Float32Array([1, 2]));
+    }, /Expected a Float64Array, got a Float32Array/);
+  });
+
+  it('not a TypedArray', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.sum([1, 2]);
+    }, /Expected a Float64Array/);
+  });
+});
+
+describe('binary data to (void *, length)', () => {
+  it('ArrayBuffer', () => {
+    assert.strictEqual(dll.byteSum(new Uint8Array([1, 2, 3]).buffer), 6);
+  });
+
+  it('TypedArray', () => {
+    assert.strictEqual(dll.byteSum(new Uint16Array([0x0101, 0x0202])), 6);
+  });
+
+  it('DataView', () => {
+    const ab = new Uint8Array([1, 2, 3, 4]).buffer;
+    assert.strictEqual(dll.byteSum(new DataView(ab, 1, 2)), 5);
+  });
+
+  it('exception', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.byteSum('string');
+    }, /Expected an ArrayBuffer or an ArrayBufferView/);
+  });
+});
+
+describe('multiple JS arguments to one C++ argument', () => {
+  it('nominal', () => {
+    assert.strictEqual(dll.rangeLength(2, 10), 8);
+  });
+
+  it('argument count', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.rangeLength(2, 10, 1);
+    }, /Expected 2 arguments, got 3/);
+  });
+
+  it('exception', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.rangeLength(2, 'a');
+    }, /Expected two numbers/);
+  });
+});
@@ -0,0 +1,16 @@
+#include <fixtures/array_members.h>
+
+#include <nobind.h>
+
+NOBIND_MODULE(array_members, m) {
+  m.def<Transform>("Transform")
+      .cons<>()
+      // Array members of numbers are TypedArray views
+      .def<&Transform::matrix>("matrix")
+      .def<&Transform::position>("position")
+      .def<&Transform::flags>("flags")
+      .def<&Transform::trace>("trace")
+      .def<&Transform::x>("x")
+      // std::arrays returned by value are copied
+      .def<&Transform::scaled>("scaled");
+}
@@ -0,0 +1,52 @@
+const { assert } = require('chai');
+
+describe('array members', () => {
+  it('TypedArray views', () => {
+    const t = new dll.Transform();
+    assert.instanceOf(t.matrix, Float32Array);
+    assert.lengthOf(t.matrix, 16);
+    assert.instanceOf(t.position, Float64Array);
+    assert.lengthOf(t.position, 3);
+    assert.instanceOf(t.flags, Int32Array);
+    assert.strictEqual(t.trace(), 4);
+  });
+
+  it('writes are shared with C++', () => {
+    const t = new dll.Transform();
+    t.matrix.set([2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2]);
+    assert.strictEqual(t.trace(), 8);
+    t.position[0] = 17;
+    assert.strictEqual(t.x(), 17);
+  });
+
+  it('views are cached', () => {
+    const t = new dll.Transform();
+    assert.strictEqual(t.matrix, t.matrix);
+    assert.strictEqual(t.position, t.position);
+    assert.notStrictEqual(t.matrix, new dll.Transform().matrix);
+  });
+
+  it('views keep their parent alive', () => {
+    const m = new dll.Transform().matrix;
+    assert.instanceOf(m.__nobind_parent_reference, dll.Transform);
+    assert.strictEqual(m[0], 1);
+  });
+
+  it('cannot be reassigned', () => {
+    const t = new dll.Transform();
+    assert.throws(() => {
+      'use strict';
+      t.matrix = new Float32Array(16);
+    }, /Cannot set property|only a getter/);
+  });
+
+  it('std::array returned by value', () => {
+    const t = new dll.Transform();
+    t.position.set([1, 2, 3]);
+    const r = t.scaled(2);
+    assert.instanceOf(r, Float64Array);
+    assert.deepStrictEqual(Array.from(r), [2, 4, 6]);
+    r[0] = 0;
+    assert.strictEqual(t.x(), 1);
+  });
+});
@@ -0,0 +1,19 @@
+#include <fixtures/batch.h>
+
+#include <nobind.h>
+
+NOBIND_MODULE(batch, m) {
+  m.def<&add>("add")
+      // The same function called once for each element of its arguments
+      .def<&add, Nobind::ReturnBatch>("addBatch")
+      .def<&scale, Nobind::ReturnBatch>("scaleBatch")
+      .def<&positive, Nobind::ReturnBatch>("positiveBatch")
+      .def<&greet, Nobind::ReturnBatch>("greetBatch")
+      .def<&accumulate, Nobind::ReturnBatch>("accumulateBatch")
+      .def<&total>("total");
+
+  m.def<Accumulator>("Accumulator")
+      .cons<>()
+      .def<&Accumulator::sum, Nobind::ReadOnly>("sum")
+      .def<&Accumulator::add, Nobind::ReturnBatch>("addBatch");
+}
@@ -0,0 +1,59 @@
+const { assert } = require('chai');
+
+describe('batch calls', () => {
+  it('TypedArray arguments', () => {
+    const r = dll.addBatch(new Float64Array([1, 2, 3]), new Float64Array([10, 20, 30]));
+    assert.instanceOf(r, Float64Array);
+    assert.deepStrictEqual(Array.from(r), [11, 22, 33]);
+  });
+
+  it('array arguments', () => {
+    const r = dll.addBatch([1, 2, 3], new Float64Array([0.5, 0.5, 0.5]));
+    assert.instanceOf(r, Float64Array);
+    assert.deepStrictEqual(Array.from(r), [1.5, 2.5, 3.5]);
+  });
+
+  it('TypedArrays of another type are converted', () => {
+    const r = dll.scaleBatch(new Float64Array([1, 2]), new Int32Array([3, 3]));
+    assert.instanceOf(r, Int32Array);
+    assert.deepStrictEqual(Array.from(r), [3, 6]);
+  });
+
+  it('non-number results', () => {
+    assert.deepStrictEqual(dll.positiveBatch([-1, 0, 2]), [false, false, true]);
+    assert.deepStrictEqual(dll.greetBatch(['Garga', 'Gargamel']), ['Hello Garga', 'Hello Gargamel']);
+  });
+
+  it('void functions', () => {
+    const before = dll.total();
+    assert.isUndefined(dll.accumulateBatch(new Float64Array([1, 2, 3])));
+    assert.strictEqual(dll.total(), before + 6);
+  });
+
+  it('empty arrays', () => {
+    const r = dll.addBatch([], new Float64Array(0));
+    assert.instanceOf(r, Float64Array);
+    assert.lengthOf(r, 0);
+  });
+
+  it('class methods', () => {
+    const acc = new dll.Accumulator();
+    const r = acc.addBatch(new Float64Array([1, 2, 3]));
+    assert.deepStrictEqual(Array.from(r), [1, 3, 6]);
+    assert.strictEqual(acc.sum, 6);
+  });
+
+  it('throws on mismatched lengths', () => {
+    assert.throws(() => dll.addBatch([1, 2], [1]), RangeError, /same length/);
+  });
+
+  it('throws on invalid arguments', () => {
+    assert.throws(() => dll.addBatch(1, 2), TypeError, /array or a TypedArray/);
+    assert.throws(() => dll.addBatch(['a'], [1]), TypeError, /Expected a number/);
+    assert.throws(() => dll.addBatch([1]), TypeError, /Expected 2 arguments/);
+  });
+
+  it('C++ exceptions', () => {
+    assert.throws(() => dll.scaleBatch([1, 2], [1, 0]), Error, /factor cannot be zero/);
+  });
+});
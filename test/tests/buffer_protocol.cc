@@ -0,0 +1,30 @@
+#include <fixtures/buffer_protocol.h>
+
+#include <nobind.h>
+
+// The buffer protocol is implemented by a class extension
+// that describes the memory of the object
+Nobind::BufferInfo<uint8_t> image_pixels(Image &img) {
+  return {img.data(), img.size(), {img.height, img.width, img.channels}};
+}
+
+Nobind::BufferInfo<const uint8_t> image_pixels_const(const Image &img) {
+  return {img.data(), img.size(), {img.height, img.width, img.channels}};
+}
+
+Nobind::BufferInfo<float> matrix_data(Matrix &m) { return {m.data(), m.rows * m.cols, {m.rows, m.cols}, {m.cols, 1}}; }
+
+NOBIND_MODULE(buffer_protocol, m) {
+  m.def<Image>("Image")
+      .cons<size_t, size_t, size_t>()
+      .def<&Image::get>("get")
+      .def<&Image::set>("set")
+      .ext<&image_pixels, Nobind::ReturnNested>("pixels")
+      .ext<&image_pixels_const, Nobind::ReturnNested>("pixelsConst");
+
+  m.def<Matrix>("Matrix")
+      .cons<size_t, size_t>()
+      .def<&Matrix::get>("get")
+      .def<&Matrix::sum>("sum")
+      .ext<&matrix_data, Nobind::ReturnNested>("data");
+}
@@ -0,0 +1,50 @@
+const { assert } = require('chai');
+
+describe('buffer protocol', () => {
+  it('TypedArray view', () => {
+    const img = new dll.Image(4, 3, 2);
+    const pixels = img.pixels();
+    assert.instanceOf(pixels, Uint8Array);
+    assert.lengthOf(pixels, 4 * 3 * 2);
+    assert.deepStrictEqual(pixels.shape, [3, 4, 2]);
+    assert.isUndefined(pixels.strides);
+    assert.strictEqual(pixels[(1 * 4 + 2) * 2 + 1], img.get(2, 1, 1));
+  });
+
+  it('writes are shared with C++', () => {
+    const img = new dll.Image(4, 3, 2);
+    const pixels = img.pixels();
+    pixels[(2 * 4 + 3) * 2 + 0] = 117;
+    assert.strictEqual(img.get(3, 2, 0), 117);
+    img.set(0, 0, 1, 42);
+    assert.strictEqual(pixels[1], 42);
+    assert.strictEqual(img.pixelsConst()[1], 42);
+  });
+
+  it('const buffers are copied', () => {
+    const img = new dll.Image(4, 3, 2);
+    const pixels = img.pixelsConst();
+    assert.strictEqual(pixels[1], img.get(0, 0, 1));
+    pixels[1] = 99;
+    assert.notStrictEqual(img.get(0, 0, 1), 99);
+    img.set(0, 0, 1, 42);
+    assert.strictEqual(pixels[1], 99);
+  });
+
+  it('shape and strides', () => {
+    const m = new dll.Matrix(3, 5);
+    const data = m.data();
+    assert.instanceOf(data, Float32Array);
+    assert.deepStrictEqual(data.shape, [3, 5]);
+    assert.deepStrictEqual(data.strides, [5, 1]);
+    data[1 * data.strides[0] + 2 * data.strides[1]] = 2.5;
+    assert.strictEqual(m.get(1, 2), 2.5);
+    assert.strictEqual(m.sum(), 2.5);
+  });
+
+  it('the view keeps the object alive', () => {
+    const pixels = new dll.Image(2, 2, 1).pixels();
+    assert.instanceOf(pixels.__nobind_parent_reference, dll.Image);
+    assert.deepStrictEqual(Array.from(pixels), [0, 1, 2, 3]);
+  });
+});
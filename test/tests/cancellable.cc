@@ -0,0 +1,25 @@
+#include <fixtures/cancellable.h>
+
+#include <nobind.h>
+
+int32_t runs() { return cancellable_runs; }
+
+// The C++ function polls the token
+int32_t spin(int32_t ms, const Nobind::CancellationToken &token) {
+  return spinner(ms, [&token]() { return token.cancelled(); });
+}
+
+int32_t spinChecked(int32_t ms, Nobind::CancellationToken token) {
+  int32_t r = spinner(ms, [&token]() { return token.cancelled(); });
+  token.throwIfCancelled();
+  return r;
+}
+
+NOBIND_MODULE(cancellable, m) {
+  m.def<&runs>("runs")
+      .def<&sleeper, Nobind::ReturnCancellable>("sleeper")
+      .def<&spin, Nobind::ReturnCancellable>("spin")
+      .def<&spinChecked, Nobind::ReturnCancellable>("spinChecked")
+      // Without a signal, the token is never cancelled
+      .def<&spin, Nobind::ReturnAsync>("spinAsync");
+}
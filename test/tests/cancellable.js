@@ -0,0 +1,55 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('cancellable async calls', () => {
+  it('without a signal', () => Promise.all([
+    assert.becomes(dll.sleeper(1), 1),
+    assert.becomes(dll.sleeper(1, undefined), 1),
+    assert.becomes(dll.spinAsync(5), 5)
+  ]));
+
+  it('an aborted signal rejects immediately', async () => {
+    const runs = dll.runs();
+    const ctrl = new AbortController();
+    ctrl.abort();
+    await assert.isRejected(dll.sleeper(1, ctrl.signal), /aborted/);
+    assert.strictEqual(dll.runs(), runs);
+  });
+
+  it('aborting a queued call removes it from the thread pool', async () => {
+    const runs = dll.runs();
+    // Saturate the thread pool
+    const busy = Array.from({ length: 16 }, () => dll.sleeper(50));
+    const ctrl = new AbortController();
+    const q = dll.sleeper(1, ctrl.signal);
+    ctrl.abort();
+    await assert.isRejected(q, /aborted/);
+    await Promise.all(busy);
+    assert.strictEqual(dll.runs(), runs + 16);
+  });
+
+  it('CancellationToken', async () => {
+    const ctrl = new AbortController();
+    const q = dll.spin(5000, ctrl.signal);
+    setTimeout(() => ctrl.abort(), 20);
+    const start = Date.now();
+    await assert.isRejected(q, /aborted/);
+    assert.isBelow(Date.now() - start, 2000);
+  });
+
+  it('timeouts with AbortSignal.timeout()', async () => {
+    const start = Date.now();
+    await assert.isRejected(dll.spinChecked(5000, AbortSignal.timeout(20)), /timed out|aborted/);
+    assert.isBelow(Date.now() - start, 2000);
+    await assert.becomes(dll.spinChecked(5, AbortSignal.timeout(5000)), 5);
+  });
+
+  it('invalid signals', () => Promise.all([
+    // @ts-expect-error
+    assert.isRejected(dll.sleeper(1, 42), /Expected an AbortSignal/),
+    // @ts-expect-error
+    assert.isRejected(dll.sleeper(1, {}, 2), /Expected 1 arguments, got 3/)
+  ]));
+});
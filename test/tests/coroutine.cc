@@ -0,0 +1,69 @@
+// NOBIND_TEST_STD c++20
+#include <fixtures/coroutine.h>
+
+#include <nobind.h>
+
+#include <stdexcept>
+#include <string>
+
+// The heavy work runs in the thread pool
+Nobind::Task<int32_t> square(int32_t v) {
+  co_await Nobind::ResumeOnWorker();
+  int32_t r = slow_square(v);
+  co_await Nobind::ResumeOnMain();
+  co_return r;
+}
+
+// Records the thread of each step, M for the main thread and W for the thread pool
+Nobind::Task<std::string> hops(int32_t n) {
+  std::string r;
+  for (int32_t i = 0; i < n; i++) {
+    r += on_main_thread() ? "M" : "W";
+    co_await Nobind::ResumeOnWorker();
+    r += on_main_thread() ? "M" : "W";
+    co_await Nobind::ResumeOnMain();
+  }
+  r += on_main_thread() ? "M" : "W";
+  co_return r;
+}
+
+// Tasks awaiting Tasks do not go through JS
+Nobind::Task<int32_t> chained(int32_t v) {
+  int32_t a = co_await square(v);
+  int32_t b = co_await square(a);
+  co_return b;
+}
+
+// Returns from the thread pool, the Promise is still settled on the main thread
+Nobind::Task<int32_t> finishOnWorker(int32_t v) {
+  co_await Nobind::ResumeOnWorker();
+  co_return slow_square(v);
+}
+
+Nobind::Task<int32_t> immediate(int32_t v) { co_return v; }
+
+Nobind::Task<> empty() { co_await Nobind::ResumeOnWorker(); }
+
+// Coroutine parameters are passed by value, references are rejected at compile time
+Nobind::Task<int32_t> failing(std::string msg) {
+  co_await Nobind::ResumeOnWorker();
+  throw std::runtime_error(msg);
+}
+
+// Exceptions that are not std::exceptions
+Nobind::Task<int32_t> failingUnknown() {
+  co_await Nobind::ResumeOnWorker();
+  throw 42;
+}
+
+NOBIND_MODULE(coroutine, m) {
+  remember_main_thread();
+  m.def<&square>("square")
+      .def<&hops>("hops")
+      .def<&chained>("chained")
+      .def<&finishOnWorker>("finishOnWorker")
+      .def<&immediate>("immediate")
+      .def<&empty>("empty")
+      .def<&failing>("failing")
+      .def<&failingUnknown>("failingUnknown");
+}
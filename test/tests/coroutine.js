@@ -0,0 +1,34 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('C++20 coroutines', () => {
+  it('Task<T> returns a Promise', () => Promise.all([
+    assert.becomes(dll.square(3), 9),
+    assert.becomes(dll.immediate(5), 5),
+    assert.becomes(dll.empty(), undefined),
+    assert.becomes(dll.finishOnWorker(4), 16)
+  ]));
+
+  it('hops between the main thread and the thread pool', () =>
+    assert.becomes(dll.hops(3), 'MWMWMWM')
+  );
+
+  it('Tasks can await Tasks', () =>
+    assert.becomes(dll.chained(3), 81)
+  );
+
+  it('exceptions reject the Promise', () =>
+    assert.isRejected(dll.failing('coroutine failed'), /coroutine failed/)
+  );
+
+  it('unknown exceptions reject the Promise', () =>
+    assert.isRejected(dll.failingUnknown(), /Unknown exception/)
+  );
+
+  it('concurrent calls', async () => {
+    const input = Array.from({ length: 32 }, (_, i) => i);
+    assert.deepStrictEqual(await Promise.all(input.map((i) => dll.chained(i))), input.map((i) => i ** 4));
+  });
+});
@@ -0,0 +1,57 @@
+#include <fixtures/deferred.h>
+
+#include <nooverrides.h>
+
+namespace Nobind {
+namespace Typemap {
+// A two-phase typemap: in async calls, the constructor only copies the string
+// and it is split in words by Get() on the worker thread
+template <> class FromJS<const Words &> {
+  std::string raw_;
+  Words val_;
+
+public:
+  inline explicit FromJS(const Napi::Value &val) : FromJS(val, FromJSDeferred{}) {
+    Split();
+    val_.deferred = false;
+  }
+  inline FromJS(const Napi::Value &val, FromJSDeferred) {
+    if (!val.IsString()) {
+      throw Napi::TypeError::New(val.Env(), "Expected a string");
+    }
+    raw_ = val.ToString().Utf8Value();
+    val_.deferred = true;
+  }
+  inline void Split() {
+    size_t start = 0;
+    while (start < raw_.size()) {
+      size_t end = raw_.find(' ', start);
+      if (end == std::string::npos)
+        end = raw_.size();
+      if (end > start)
+        val_.list.push_back(raw_.substr(start, end - start));
+      start = end + 1;
+    }
+    raw_.clear();
+  }
+  inline const Words &Get() {
+    if (val_.deferred)
+      Split();
+    return val_;
+  }
+
+  static const std::string TSType() { return "string"; };
+};
+} // namespace Typemap
+} // namespace Nobind
+
+#include <nobind.h>
+
+NOBIND_MODULE(deferred, m) {
+  // The async versions convert the long strings on the worker thread
+  m.def<&echo>("echo", "echoAsync");
+  m.def<&join>("join", "joinAsync");
+  m.def<&concat_values>("concatValues", "concatValuesAsync");
+  m.def<&word_count>("wordCount", "wordCountAsync");
+  m.def<&last_deferred>("lastDeferred");
+}
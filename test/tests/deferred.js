@@ -0,0 +1,47 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('deferred argument conversion', () => {
+  const long = 'é中\u{1F600}ascii'.repeat(1000);
+  const lone = 'x'.repeat(300) + '\uD800' + 'y' + '\uDC00';
+  const ascii = 'ascii '.repeat(1000);
+  const latin1 = 'café '.repeat(1000);
+
+  it('long strings', () =>
+    Promise.all([
+      dll.echoAsync(long).then((r) => assert.strictEqual(r, long)),
+      dll.echoAsync(lone).then((r) => assert.strictEqual(r, dll.echo(lone))),
+      dll.echoAsync(ascii).then((r) => assert.strictEqual(r, ascii)),
+      dll.echoAsync(latin1).then((r) => assert.strictEqual(r, latin1)),
+      dll.echoAsync('short').then((r) => assert.strictEqual(r, 'short'))
+    ]));
+
+  it('lone surrogates are replaced', () =>
+    dll.echoAsync(lone).then((r) => assert.strictEqual(r, 'x'.repeat(300) + '�y�')));
+
+  it('vectors and maps of strings', () =>
+    Promise.all([
+      dll.joinAsync([long, 'a', long], '|').then((r) => assert.strictEqual(r, dll.join([long, 'a', long], '|'))),
+      dll
+        .concatValuesAsync({ a: long, b: 'b' })
+        .then((r) => assert.strictEqual(r, dll.concatValues({ a: long, b: 'b' })))
+    ]));
+
+  it('custom two-phase typemaps', () => {
+    assert.strictEqual(dll.wordCount('one two  three'), 3);
+    assert.isFalse(dll.lastDeferred());
+    return dll.wordCountAsync('one two  three four').then((r) => {
+      assert.strictEqual(r, 4);
+      assert.isTrue(dll.lastDeferred());
+    });
+  });
+
+  it('type errors are still raised on the main thread', () =>
+    Promise.all([
+      assert.isRejected(dll.echoAsync(1), /Expected a string/),
+      assert.isRejected(dll.joinAsync([long, 1], ''), /Expected a string/),
+      assert.isRejected(dll.wordCountAsync(1), /Expected a string/)
+    ]));
+});
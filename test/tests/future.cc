@@ -0,0 +1,13 @@
+#include <fixtures/future.h>
+
+#include <nobind.h>
+
+NOBIND_MODULE(future, m) {
+  m.def<&future_value>("value")
+      .def<&future_void>("empty")
+      .def<&future_promise>("promise")
+      .def<&future_throws>("throws")
+      .def<&future_deferred>("deferred")
+      .def<&future_invalid>("invalid")
+      .def<&future_shared>("shared");
+}
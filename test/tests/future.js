@@ -0,0 +1,52 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('std::future', () => {
+  it('std::future is converted to a Promise', () => Promise.all([
+    assert.becomes(dll.value(42, 10), 42),
+    assert.becomes(dll.empty(10), undefined),
+    assert.becomes(dll.promise('resolved', 10), 'resolved'),
+    assert.becomes(dll.deferred(21), 42)
+  ]));
+
+  it('exceptions reject the Promise', () =>
+    assert.isRejected(dll.throws('future failed'), /future failed/)
+  );
+
+  it('invalid futures throw', () => {
+    assert.throws(() => dll.invalid(), /Invalid future/);
+  });
+
+  it('std::shared_future', async () => {
+    assert.deepStrictEqual(await Promise.all([dll.shared(), dll.shared()]), ['shared', 'shared']);
+    assert.strictEqual(await dll.shared(), 'shared');
+  });
+
+  it('pending futures do not occupy the thread pool', async () => {
+    const start = Date.now();
+    const results = await Promise.all(Array.from({ length: 16 }, (_, i) => dll.value(i, 50)));
+    assert.deepStrictEqual(results, Array.from({ length: 16 }, (_, i) => i));
+    // With a pool of 4 threads blocked in get(), this would take at least 200ms
+    assert.isBelow(Date.now() - start, 150);
+  });
+
+  it('pending futures are released when a worker_thread exits', async () => {
+    const { Worker } = require('worker_threads');
+    const { once } = require('events');
+    const addon = Object.keys(require.cache).find((m) => m.endsWith('future.node'));
+    const worker = new Worker(
+      `
+      const { workerData } = require('worker_threads');
+      const dll = require(workerData);
+      dll.promise('pending', 500).catch(() => undefined);
+      dll.value(1, 100).catch(() => undefined);
+      setTimeout(() => process.exit(0), 20);
+      `,
+      { eval: true, workerData: addon }
+    );
+    const [code] = await once(worker, 'exit');
+    assert.strictEqual(code, 0);
+  });
+});
@@ -0,0 +1,13 @@
+#include <fixtures/inflight.h>
+
+#include <nobind.h>
+
+constexpr auto limitReject = Nobind::ReturnLimit<1, Nobind::LimitReject>;
+constexpr auto limitDrop = Nobind::ReturnLimit<1, Nobind::LimitDropOldest>;
+
+NOBIND_MODULE(inflight, m) {
+  m.def<&delayed, Nobind::ReturnLimit<2>>("delayed")
+      .def<&delayed_reject, limitReject>("delayedReject")
+      .def<&delayed_drop, limitDrop>("delayedDrop");
+  m.def<Worker>("Worker").cons<>().def<&Worker::work, Nobind::ReturnLimit<1>>("work");
+}
@@ -0,0 +1,86 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('in-flight limits of async calls', () => {
+  it('excess calls wait in the queue', async () => {
+    const calls = [1, 2, 3, 4, 5, 6].map((v) => dll.delayed(v));
+    const stats = dll.__limits().delayed;
+    assert.strictEqual(stats.max, 2);
+    assert.strictEqual(stats.inflight, 2);
+    assert.strictEqual(stats.queued, 4);
+    assert.deepStrictEqual(await Promise.all(calls), [1, 2, 3, 4, 5, 6]);
+    assert.strictEqual(dll.__limits().delayed.inflight, 0);
+    assert.strictEqual(dll.__limits().delayed.queued, 0);
+  });
+
+  it('calls finishing together with fewer waiting calls', async () => {
+    const calls = [1, 2, 3].map((v) => dll.delayed(v));
+    assert.strictEqual(dll.__limits().delayed.queued, 1);
+    assert.deepStrictEqual(await Promise.all(calls), [1, 2, 3]);
+    assert.strictEqual(dll.__limits().delayed.inflight, 0);
+    const next = [4, 5].map((v) => dll.delayed(v));
+    assert.strictEqual(dll.__limits().delayed.inflight, 2);
+    assert.strictEqual(dll.__limits().delayed.queued, 0);
+    assert.deepStrictEqual(await Promise.all(next), [4, 5]);
+  });
+
+  it('waiting calls are converted when they are replayed', async () => {
+    const first = dll.delayed(1);
+    const second = dll.delayed(2);
+    const invalid = dll.delayed('invalid');
+    const last = dll.delayed(4);
+    assert.strictEqual(dll.__limits().delayed.queued, 2);
+    await assert.isRejected(invalid, /Expected a number/);
+    assert.deepStrictEqual(await Promise.all([first, second, last]), [1, 2, 4]);
+    assert.strictEqual(dll.__limits().delayed.inflight, 0);
+  });
+
+  it('LimitReject rejects the excess calls', async () => {
+    const calls = [1, 2, 3].map((v) => dll.delayedReject(v));
+    await assert.becomes(calls[0], 1);
+    await assert.isRejected(calls[1], /Too many calls in flight/);
+    await assert.isRejected(calls[2], /Too many calls in flight/);
+    assert.strictEqual(dll.__limits().delayedReject.rejected, 2);
+    await assert.becomes(dll.delayedReject(4), 4);
+  });
+
+  it('LimitDropOldest rejects the oldest waiting call', async () => {
+    const calls = [1, 2, 3, 4].map((v) => dll.delayedDrop(v));
+    assert.strictEqual(dll.__limits().delayedDrop.queued, 1);
+    await assert.becomes(calls[0], 1);
+    await assert.isRejected(calls[1], /Dropped/);
+    await assert.isRejected(calls[2], /Dropped/);
+    await assert.becomes(calls[3], 4);
+    assert.strictEqual(dll.__limits().delayedDrop.dropped, 2);
+  });
+
+  it('class methods', async () => {
+    const w = new dll.Worker();
+    const calls = [1, 2, 3].map((v) => w.work(v));
+    assert.strictEqual(dll.__limits()['Worker.work'].queued, 2);
+    assert.deepStrictEqual(await Promise.all(calls), [2, 4, 6]);
+  });
+
+  it('waiting calls are released when a worker_thread exits', async () => {
+    const { Worker } = require('worker_threads');
+    const { once } = require('events');
+    const addon = Object.keys(require.cache).find((m) => m.endsWith('inflight.node'));
+    const worker = new Worker(
+      `
+      const { parentPort, workerData } = require('worker_threads');
+      const dll = require(workerData);
+      for (let i = 0; i < 6; i++) dll.delayed(i).catch(() => undefined);
+      parentPort.postMessage(dll.__limits().delayed.queued);
+      process.exit(0);
+      `,
+      { eval: true, workerData: addon }
+    );
+    const messages = [];
+    worker.on('message', (msg) => messages.push(msg));
+    const [code] = await once(worker, 'exit');
+    assert.strictEqual(code, 0);
+    assert.deepStrictEqual(messages, [4]);
+  });
+});
@@ -0,0 +1,13 @@
+// Generate the JS shim
+#define NOBIND_JS_SHIM
+#include <fixtures/js_shim.h>
+
+#include <nobind.h>
+
+NOBIND_MODULE(js_shim, m) {
+  m.def<&hypot3>("hypot3");
+  m.def<&hypot3, Nobind::ReturnAsync>("hypot3Async");
+  m.def<&scale>("scale");
+  m.def<&greet>("greet");
+  m.def<&split, Nobind::ReturnDefault, Nobind::ArgOutput<1, 2>>("split");
+}
@@ -0,0 +1,46 @@
+const { assert } = require('chai');
+
+describe('JS shim', () => {
+  let shim;
+
+  before(() => {
+    const mod = { exports: {} };
+    new Function('module', 'exports', dll.__shim)(mod, mod.exports);
+    shim = mod.exports(dll);
+  });
+
+  it('generated module', () => {
+    assert.isString(dll.__shim);
+    assert.isFunction(shim.hypot3);
+    assert.notStrictEqual(shim.hypot3, dll.hypot3);
+    assert.isFunction(dll.__nobind_unchecked_hypot3);
+  });
+
+  it('nominal', () => {
+    assert.strictEqual(shim.hypot3(2, 3, 6), 7);
+    assert.strictEqual(shim.scale(3, true), 6);
+    assert.strictEqual(shim.scale(3, false), 3);
+    assert.strictEqual(shim.greet('Garga'), 'Hello, Garga');
+    assert.deepStrictEqual(shim.split(2.5), [2, 0.5]);
+  });
+
+  it('hot loop', () => {
+    let r = 0;
+    for (let i = 0; i < 10000; i++) r += shim.scale(i, true);
+    assert.strictEqual(r, 99990000);
+  });
+
+  it('argument checking', () => {
+    assert.throws(() => shim.hypot3(1, 2), /Expected 3 arguments, got 2/);
+    assert.throws(() => shim.hypot3(1, 2, '3'), /Expected a number/);
+    assert.throws(() => shim.scale(1, 1), /Expected a boolean/);
+    assert.throws(() => shim.split(), /Expected 1 arguments, got 0/);
+    // Strings are still checked by C++
+    assert.throws(() => shim.greet(1), /Expected a string/);
+  });
+
+  it('async', () => shim.hypot3Async(2, 3, 6)
+    .then((r) => assert.strictEqual(r, 7)));
+
+  it('async argument checking', () => assert.isRejected(shim.hypot3Async(2, 3, 'a'), /Expected a number/));
+});
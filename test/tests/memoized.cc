@@ -0,0 +1,17 @@
+// A small cache to exercise the evictions
+#define NOBIND_MEMOIZE_SIZE 4
+
+#include <fixtures/memoized.h>
+
+#include <nobind.h>
+
+constexpr auto memoizedAsync = Nobind::ReturnMemoized | Nobind::ReturnAsync;
+
+NOBIND_MODULE(memoized, m) {
+  m.def<&memoized_calls, Nobind::ReadOnly>("calls")
+      .def<&distance, Nobind::ReturnMemoized>("distance")
+      .def<&greeting, Nobind::ReturnMemoized>("greeting")
+      .def<&greeting, memoizedAsync>("greetingAsync")
+      .def<&checked_length, Nobind::ReturnMemoized>("checkedLength");
+  m.def<Geodesy>("Geodesy").def<&Geodesy::degrees, Nobind::ReturnMemoized>("degrees");
+}
@@ -0,0 +1,86 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('memoized functions', () => {
+  beforeEach(() => {
+    for (const binding of Object.values(dll.__memoized())) binding.clear();
+  });
+
+  it('repeated calls hit the cache', () => {
+    const calls = dll.calls;
+    const d = dll.distance(48.85, 2.35, 51.5, -0.12);
+    assert.closeTo(d, 343, 1);
+    assert.strictEqual(dll.distance(48.85, 2.35, 51.5, -0.12), d);
+    assert.strictEqual(dll.calls, calls + 1);
+    dll.distance(48.85, 2.35, 51.5, 0);
+    assert.strictEqual(dll.calls, calls + 2);
+    const stats = dll.__memoized().distance;
+    assert.strictEqual(stats.hits, 1);
+    assert.strictEqual(stats.size, 2);
+  });
+
+  it('string arguments and results', () => {
+    const calls = dll.calls;
+    assert.strictEqual(dll.greeting('World', 2), 'Hello World! Hello World! ');
+    assert.strictEqual(dll.greeting('World', 2), 'Hello World! Hello World! ');
+    assert.strictEqual(dll.greeting('World', 1), 'Hello World! ');
+    assert.strictEqual(dll.calls, calls + 2);
+  });
+
+  it('least recently used entries are evicted', () => {
+    for (let i = 0; i < 5; i++) dll.greeting('x', i);
+    const stats = dll.__memoized().greeting;
+    assert.strictEqual(stats.size, 4);
+    assert.strictEqual(stats.evictions, 1);
+    const calls = dll.calls;
+    dll.greeting('x', 4);
+    assert.strictEqual(dll.calls, calls);
+    dll.greeting('x', 0);
+    assert.strictEqual(dll.calls, calls + 1);
+  });
+
+  it('clear() empties the cache', () => {
+    dll.distance(1, 2, 3, 4);
+    const cache = dll.__memoized().distance;
+    assert.strictEqual(cache.size, 1);
+    cache.clear();
+    assert.strictEqual(dll.__memoized().distance.size, 0);
+  });
+
+  it('exceptions are not cached', () => {
+    const calls = dll.calls;
+    assert.throws(() => dll.checkedLength(''), /empty/);
+    assert.throws(() => dll.checkedLength(''), /empty/);
+    assert.strictEqual(dll.calls, calls + 2);
+  });
+
+  it('async hits skip the tasklet', async () => {
+    const calls = dll.calls;
+    assert.strictEqual(await dll.greetingAsync('async', 1), 'Hello async! ');
+    const r = await Promise.all([dll.greetingAsync('async', 1), dll.greetingAsync('async', 1)]);
+    assert.deepStrictEqual(r, ['Hello async! ', 'Hello async! ']);
+    assert.strictEqual(dll.calls, calls + 1);
+    assert.strictEqual(dll.__memoized().greetingAsync.hits, 2);
+  });
+
+  it('async calls with long strings are looked up on the worker thread', async () => {
+    const name = 'ü'.repeat(1024);
+    const calls = dll.calls;
+    assert.strictEqual(await dll.greetingAsync(name, 1), `Hello ${name}! `);
+    assert.strictEqual(await dll.greetingAsync(name, 1), `Hello ${name}! `);
+    assert.strictEqual(dll.calls, calls + 1);
+    const stats = dll.__memoized().greetingAsync;
+    assert.strictEqual(stats.hits, 1);
+    assert.strictEqual(stats.size, 1);
+  });
+
+  it('static methods', () => {
+    const calls = dll.calls;
+    assert.closeTo(dll.Geodesy.degrees(Math.PI), 180, 1e-9);
+    assert.closeTo(dll.Geodesy.degrees(Math.PI), 180, 1e-9);
+    assert.strictEqual(dll.calls, calls + 1);
+    assert.strictEqual(dll.__memoized()['Geodesy.degrees'].hits, 1);
+  });
+});
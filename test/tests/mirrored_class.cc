@@ -0,0 +1,24 @@
+#include <fixtures/mirrored_class.h>
+
+#include <nobind.h>
+
+NOBIND_MODULE(mirrored_class, m) {
+  m.def<Particle>("Particle")
+      // The number fields are JS accessors reading the C++ object through a DataView
+      .mirror()
+      .cons<>()
+      .cons<double, double>()
+      .def<&Particle::x>("x")
+      .def<&Particle::y>("y")
+      .def<&Particle::mass>("mass")
+      .def<&Particle::charge>("charge")
+      .def<&Particle::id, Nobind::ReadOnly>("id")
+      .def<&Particle::active>("active")
+      .def<&Particle::energy>("energy")
+      .def<&Particle::move>("move");
+
+  // The inherited fields remain mirrored, its own fields are native accessors
+  m.def<Ion, Particle>("Ion").cons<double, double, int32_t>().def<&Ion::electrons>("electrons");
+
+  m.def<&collide>("collide");
+}
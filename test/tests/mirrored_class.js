@@ -0,0 +1,102 @@
+const { assert } = require('chai');
+
+describe('mirrored classes', () => {
+  it('fields are JS accessors', () => {
+    const p = new dll.Particle(3, 4);
+    assert.strictEqual(p.x, 3);
+    assert.strictEqual(p.y, 4);
+    assert.strictEqual(p.mass, 1);
+    assert.strictEqual(p.charge, 0);
+    assert.strictEqual(p.id, 0);
+    assert.isTrue(p.active);
+    assert.instanceOf(p.__nobind_mirror, DataView);
+    const desc = Object.getOwnPropertyDescriptor(dll.Particle.prototype, 'x');
+    assert.isFunction(desc.get);
+    assert.isFunction(desc.set);
+  });
+
+  it('JS writes are visible to C++', () => {
+    const p = new dll.Particle();
+    p.x = 3;
+    p.y = 4;
+    p.mass = 2;
+    assert.strictEqual(p.energy(), 25);
+  });
+
+  it('C++ writes are visible to JS', () => {
+    const p = new dll.Particle(1, 2);
+    p.move(1, 1);
+    assert.strictEqual(p.x, 2);
+    assert.strictEqual(p.y, 3);
+  });
+
+  it('type checking', () => {
+    const p = new dll.Particle();
+    assert.throws(() => {
+      p.x = '1';
+    }, /Expected a number/);
+    assert.throws(() => {
+      p.active = 1;
+    }, /Expected a boolean/);
+    p.active = true;
+    assert.isTrue(p.active);
+    p.charge = -2;
+    assert.strictEqual(p.charge, -2);
+  });
+
+  it('read-only fields', () => {
+    const p = new dll.Particle();
+    assert.throws(() => {
+      'use strict';
+      p.id = 2;
+    }, /Cannot set property id of #<Particle> which has only a getter/);
+    assert.throws(() => {
+      p.id = 2;
+    }, TypeError);
+    assert.strictEqual(p.id, 0);
+  });
+
+  it('inheriting from a mirrored class', () => {
+    const ion = new dll.Ion(3, 4, 2);
+    assert.instanceOf(ion, dll.Particle);
+    assert.instanceOf(ion.__nobind_mirror, DataView);
+    assert.strictEqual(ion.x, 3);
+    assert.strictEqual(ion.charge, -2);
+    assert.strictEqual(ion.electrons, 2);
+    ion.x = 1;
+    ion.y = 2;
+    ion.mass = 2;
+    assert.strictEqual(ion.energy(), 5);
+    ion.electrons = 3;
+    assert.strictEqual(ion.electrons, 3);
+    assert.throws(() => {
+      ion.id = 2;
+    }, /Cannot set property id of #<Ion> which has only a getter/);
+  });
+
+  it('detaching the buffer does not free the C++ object', () => {
+    const p = new dll.Particle(3, 4);
+    const buffer = p.__nobind_mirror.buffer;
+    structuredClone(buffer, { transfer: [buffer] });
+    assert.strictEqual(buffer.byteLength, 0);
+    assert.throws(() => p.x, TypeError);
+    global.gc();
+    p.move(1, 1);
+    assert.strictEqual(p.energy(), 20.5);
+  });
+
+  it('objects returned by C++', () => {
+    const a = new dll.Particle(0, 0);
+    const b = new dll.Particle(2, 4);
+    a.charge = 1;
+    b.charge = 2;
+    const r = dll.collide(a, b);
+    assert.instanceOf(r, dll.Particle);
+    assert.strictEqual(r.x, 1);
+    assert.strictEqual(r.y, 2);
+    assert.strictEqual(r.mass, 2);
+    assert.strictEqual(r.charge, 3);
+    r.x = 5;
+    assert.strictEqual(r.energy(), 29);
+  });
+});
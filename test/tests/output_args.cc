@@ -0,0 +1,43 @@
+#include <fixtures/output_args.h>
+
+#include <nobind.h>
+
+#include <cstdlib>
+
+namespace Nobind {
+namespace Typemap {
+// A (char **, size_t *) output pair allocated with malloc() is returned as a Buffer
+template <> class ToJSMulti<char **, size_t *> {
+  Napi::Env env_;
+  char *data_;
+  size_t len_;
+
+public:
+  inline explicit ToJSMulti(Napi::Env env) : env_(env), data_(nullptr), len_(0) {}
+  ~ToJSMulti() { std::free(data_); }
+  template <size_t N> inline auto Get() {
+    if constexpr (N == 0)
+      return &data_;
+    else
+      return &len_;
+  }
+  inline Napi::Value Get() { return Napi::Buffer<char>::Copy(env_, data_, len_); }
+  ToJSMulti(const ToJSMulti &) = delete;
+  ToJSMulti(ToJSMulti &&other) : env_(other.env_), data_(other.data_), len_(other.len_) { other.data_ = nullptr; }
+
+  static std::string TSType() { return "Buffer"; }
+};
+} // namespace Typemap
+} // namespace Nobind
+
+NOBIND_MODULE(output_args, m) {
+  m.def<&polar_to_cartesian, Nobind::ReturnDefault, Nobind::ArgOutput<2, 3>>("polarToCartesian",
+                                                                            "polarToCartesianAsync");
+  m.def<&parse_int, Nobind::ReturnDefault, Nobind::ArgOutput<1>>("parseInt");
+  m.def<&library_name, Nobind::ReturnDefault, Nobind::ArgOutput<0>>("libraryName");
+  // Two C++ output arguments produce one JS value
+  m.def<&repeat_bytes, Nobind::ReturnDefault, Nobind::ArgOutput<2>>("repeatBytes", "repeatBytesAsync");
+  m.def<Accumulator>("Accumulator")
+      .cons<>()
+      .def<&Accumulator::add, Nobind::ReturnDefault, Nobind::ArgOutput<1>>("add", "addAsync");
+}
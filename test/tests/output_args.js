@@ -0,0 +1,62 @@
+const { assert } = require('chai');
+
+describe('output arguments', () => {
+  it('multiple output arguments', () => {
+    const r = dll.polarToCartesian(2, Math.PI / 2);
+    assert.isArray(r);
+    assert.lengthOf(r, 2);
+    assert.closeTo(r[0], 0, 1e-9);
+    assert.closeTo(r[1], 2, 1e-9);
+  });
+
+  it('async', () => dll.polarToCartesianAsync(2, 0)
+    .then((r) => {
+      assert.closeTo(r[0], 2, 1e-9);
+      assert.closeTo(r[1], 0, 1e-9);
+    }));
+
+  it('returned value and output argument', () => {
+    assert.deepStrictEqual(dll.parseInt('42'), [true, 42]);
+    assert.isFalse(dll.parseInt('invalid')[0]);
+  });
+
+  it('single output argument', () => {
+    const r = dll.libraryName();
+    assert.isString(r);
+    assert.strictEqual(r, 'nobind17');
+  });
+
+  it('multi-argument output', () => {
+    const r = dll.repeatBytes('ab', 3);
+    assert.isArray(r);
+    assert.strictEqual(r[0], 3);
+    assert.instanceOf(r[1], Buffer);
+    assert.strictEqual(r[1].toString(), 'ababab');
+  });
+
+  it('async multi-argument output', () => dll.repeatBytesAsync('xyz', 2)
+    .then((r) => {
+      assert.strictEqual(r[0], 2);
+      assert.strictEqual(r[1].toString(), 'xyzxyz');
+    }));
+
+  it('output arguments are not expected from JS', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.polarToCartesian(2, 0, 1, 1);
+    }, /Expected 2 arguments, got 4/);
+  });
+
+  it('class methods', () => {
+    const acc = new dll.Accumulator;
+    assert.strictEqual(acc.add(2), 2);
+    assert.strictEqual(acc.add(3), 5);
+  });
+
+  it('async class methods', () => {
+    const acc = new dll.Accumulator;
+    return acc.addAsync(7).then((r) => {
+      assert.strictEqual(r, 7);
+    });
+  });
+});
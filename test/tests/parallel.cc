@@ -0,0 +1,11 @@
+#include <fixtures/parallel.h>
+
+#include <nobind.h>
+
+NOBIND_MODULE(parallel, m) {
+  m.def<&collatz>("collatz")
+      // Batch calls split in chunks running in the thread pool
+      .def<&collatz, Nobind::ReturnParallel>("collatzParallel")
+      .def<&checked_sqrt, Nobind::ReturnParallel>("sqrtParallel")
+      .def<&repeat, Nobind::ReturnParallel>("repeatParallel");
+}
@@ -0,0 +1,44 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('parallel batch calls', () => {
+  it('returns a Promise resolved with a TypedArray', () => {
+    const input = new Uint32Array(10000).map((_, i) => i + 1);
+    const p = dll.collatzParallel(input);
+    assert.instanceOf(p, Promise);
+    return p.then((r) => {
+      assert.instanceOf(r, Uint32Array);
+      assert.lengthOf(r, input.length);
+      for (let i = 0; i < input.length; i += 97) assert.strictEqual(r[i], dll.collatz(input[i]));
+    });
+  });
+
+  it('array arguments', () =>
+    dll.sqrtParallel([1, 4, 9, 16]).then((r) => {
+      assert.instanceOf(r, Float64Array);
+      assert.deepStrictEqual(Array.from(r), [1, 2, 3, 4]);
+    }));
+
+  it('non-number results', () =>
+    dll.repeatParallel(['a', 'bc', 'd'], new Int32Array([3, 2, 0])).then((r) => {
+      assert.deepStrictEqual(r, ['aaa', 'bcbc', '']);
+    }));
+
+  it('empty arrays', () =>
+    dll.collatzParallel(new Uint32Array(0)).then((r) => {
+      assert.instanceOf(r, Uint32Array);
+      assert.lengthOf(r, 0);
+    }));
+
+  it('rejects on C++ exceptions', () =>
+    assert.isRejected(dll.sqrtParallel(new Float64Array([1, 4, -1, 16])), /negative value/));
+
+  it('rejects on invalid arguments', () =>
+    Promise.all([
+      assert.isRejected(dll.repeatParallel(['a'], [1, 2]), /same length/),
+      assert.isRejected(dll.sqrtParallel(1), /array or a TypedArray/),
+      assert.isRejected(dll.sqrtParallel(['a']), /Expected a number/)
+    ]));
+});
@@ -0,0 +1,19 @@
+// A single slot makes the order of the calls deterministic
+#define NOBIND_PRIORITY_SLOTS 1
+#define NOBIND_PRIORITY_AGING 20
+#include <fixtures/priority.h>
+
+#include <nobind.h>
+
+constexpr auto priorityHigh = Nobind::ReturnPriority<Nobind::PriorityHigh>;
+constexpr auto priorityNormal = Nobind::ReturnPriority<Nobind::PriorityNormal>;
+constexpr auto priorityBackground = Nobind::ReturnPriority<Nobind::PriorityBackground>;
+constexpr auto backgroundCancellable = priorityBackground | Nobind::ReturnCancellable;
+
+NOBIND_MODULE(priority, m) {
+  m.def<&lane_order>("order")
+      .def<&lane_task, priorityHigh>("high")
+      .def<&lane_task, priorityNormal>("normal")
+      .def<&lane_task, priorityBackground>("background")
+      .def<&lane_task, backgroundCancellable>("backgroundCancellable");
+}
@@ -0,0 +1,49 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('priority lanes', () => {
+  afterEach(() => dll.order());
+
+  it('the highest lane goes first', async () => {
+    const calls = [
+      dll.background(1, 50),
+      dll.background(2, 1),
+      dll.normal(3, 1),
+      dll.high(4, 1)
+    ];
+    const lanes = dll.__lanes();
+    assert.strictEqual(lanes.slots, 1);
+    assert.strictEqual(lanes.running, 1);
+    assert.strictEqual(lanes.background.queued, 1);
+    assert.strictEqual(lanes.normal.queued, 1);
+    assert.strictEqual(lanes.high.queued, 1);
+    assert.deepStrictEqual(await Promise.all(calls), [1, 2, 3, 4]);
+    assert.deepStrictEqual(dll.order(), [1, 4, 3, 2]);
+    assert.strictEqual(dll.__lanes().running, 0);
+  });
+
+  it('waiting calls age', async () => {
+    const promoted = dll.__lanes().background.promoted;
+    const first = dll.background(1, 150);
+    const old = dll.background(2, 1);
+    await new Promise((res) => setTimeout(res, 100));
+    const calls = [3, 4, 5].map((id) => dll.high(id, 1));
+    await Promise.all([first, old, ...calls]);
+    assert.deepStrictEqual(dll.order(), [1, 2, 3, 4, 5]);
+    assert.strictEqual(dll.__lanes().background.promoted, promoted + 1);
+  });
+
+  it('cancelled waiting calls are never queued', async () => {
+    const cancelled = dll.__lanes().background.cancelled;
+    const first = dll.high(1, 20);
+    const ctrl = new AbortController();
+    const waiting = dll.backgroundCancellable(2, 1, ctrl.signal);
+    ctrl.abort();
+    await assert.isRejected(waiting, /aborted/);
+    await first;
+    assert.deepStrictEqual(dll.order(), [1]);
+    assert.strictEqual(dll.__lanes().background.cancelled, cancelled + 1);
+  });
+});
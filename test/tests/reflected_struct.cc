@@ -0,0 +1,23 @@
+#include <fixtures/reflected_struct.h>
+
+#include <nobind.h>
+
+NOBIND_STRUCT(Point, x, y);
+NOBIND_STRUCT(Creature, name, eyes, fangs, position);
+NOBIND_STRUCT(Sample, value, count, flags);
+
+constexpr auto soaAsync = Nobind::ReturnStructOfArrays | Nobind::ReturnAsync;
+
+NOBIND_MODULE(reflected_struct, m) {
+  m.def<&distance>("distance");
+  m.def<&midpoint>("midpoint");
+  m.def<&grow>("grow");
+  m.def<&grow, Nobind::ReturnAsync>("growAsync");
+  m.def<&origin>("origin");
+  m.def<&make_points>("makePoints");
+  m.def<&make_points, Nobind::ReturnStructOfArrays>("makePointsSoA");
+  m.def<&make_points, soaAsync>("makePointsSoAAsync");
+  m.def<&sum_x>("sumX");
+  m.def<&sum_x, Nobind::ReturnDefault, Nobind::ArgStructOfArrays<0>>("sumXSoA");
+  m.def<&scale_samples, Nobind::ReturnStructOfArrays, Nobind::ArgStructOfArrays<0>>("scaleSamples");
+}
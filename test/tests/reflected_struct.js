@@ -0,0 +1,96 @@
+const { assert } = require('chai');
+
+describe('reflected structs', () => {
+  it('plain object arguments', () => {
+    assert.closeTo(dll.distance({ x: 0, y: 0 }, { x: 3, y: 4 }), 5, 1e-9);
+  });
+
+  it('plain object returned values', () => {
+    const r = dll.midpoint({ x: 0, y: 2 }, { x: 4, y: 4 });
+    assert.deepStrictEqual(r, { x: 2, y: 3 });
+    assert.deepStrictEqual(Object.keys(r), ['x', 'y']);
+    assert.deepStrictEqual(dll.origin(), { x: 0, y: 0 });
+  });
+
+  it('nested structs', () => {
+    const r = dll.grow({ name: 'Garga', eyes: 3, fangs: false, position: { x: 1, y: 2 } });
+    assert.deepStrictEqual(r, { name: 'Garga', eyes: 4, fangs: true, position: { x: 2, y: 2 } });
+  });
+
+  it('async', () => dll.growAsync({ name: 'Garga', eyes: 1, fangs: false, position: { x: 0, y: 0 } })
+    .then((r) => {
+      assert.strictEqual(r.eyes, 2);
+      assert.strictEqual(r.position.x, 1);
+    }));
+
+  it('exceptions', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.distance(1, { x: 3, y: 4 });
+    }, /Expected an object/);
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.distance({ x: 0 }, { x: 3, y: 4 });
+    }, /Expected a number/);
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.grow({ name: 'Garga', eyes: 3, fangs: false, position: null });
+    }, /Expected an object/);
+  });
+
+  describe('struct of arrays', () => {
+    it('returned vectors', () => {
+      const r = dll.makePointsSoA(4);
+      assert.instanceOf(r.x, Float64Array);
+      assert.instanceOf(r.y, Float64Array);
+      assert.deepStrictEqual(Array.from(r.x), [0, 1, 2, 3]);
+      assert.deepStrictEqual(Array.from(r.y), [0, 2, 4, 6]);
+      assert.deepStrictEqual(dll.makePoints(2), [{ x: 0, y: 0 }, { x: 1, y: 2 }]);
+    });
+
+    it('vector arguments', () => {
+      assert.strictEqual(dll.sumXSoA({ x: new Float64Array([1, 2, 3]), y: new Float64Array(3) }), 6);
+      assert.strictEqual(dll.sumX([{ x: 1, y: 0 }, { x: 2, y: 0 }]), 3);
+    });
+
+    it('mixed types', () => {
+      const r = dll.scaleSamples({
+        value: new Float64Array([1, 2]),
+        count: new Int32Array([5, 6]),
+        flags: new Uint8Array([1, 255])
+      }, 2);
+      assert.deepStrictEqual(Array.from(r.value), [2, 4]);
+      assert.instanceOf(r.count, Int32Array);
+      assert.deepStrictEqual(Array.from(r.count), [6, 7]);
+      assert.instanceOf(r.flags, Uint8Array);
+      assert.deepStrictEqual(Array.from(r.flags), [1, 255]);
+    });
+
+    it('large vectors', () => {
+      const n = 1e6;
+      const r = dll.makePointsSoA(n);
+      assert.lengthOf(r.x, n);
+      assert.strictEqual(r.y[n - 1], (n - 1) * 2);
+      assert.strictEqual(dll.sumXSoA(r), (n - 1) * n / 2);
+    });
+
+    it('async', () => dll.makePointsSoAAsync(3)
+      .then((r) => {
+        assert.deepStrictEqual(Array.from(r.x), [0, 1, 2]);
+      }));
+
+    it('exceptions', () => {
+      assert.throws(() => {
+        dll.sumXSoA({ x: new Float64Array(3), y: new Float64Array(2) });
+      }, /same length/);
+      assert.throws(() => {
+        // @ts-expect-error
+        dll.sumXSoA({ x: new Float32Array(3), y: new Float64Array(3) });
+      }, /Expected a Float64Array/);
+      assert.throws(() => {
+        // @ts-expect-error
+        dll.sumXSoA([{ x: 1, y: 2 }]);
+      }, /Expected a Float64Array/);
+    });
+  });
+});
@@ -0,0 +1,15 @@
+// Small slices to exercise the yields
+#define NOBIND_RESULT_SLICE_SIZE 16
+
+#include <fixtures/sliced.h>
+
+#include <nobind.h>
+
+NOBIND_MODULE(sliced, m) {
+  m.def<&sequence, Nobind::ReturnSliced>("sequenceSliced")
+      .def<&sequence, Nobind::ReturnStreamed>("sequenceStreamed")
+      .def<&labels, Nobind::ReturnSliced>("labelsSliced")
+      .def<&labels, Nobind::ReturnStreamed>("labelsStreamed")
+      // The elements are converted without the delivery mode of the container
+      .def<&triangle, Nobind::ReturnSliced>("triangleSliced");
+}
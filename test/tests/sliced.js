@@ -0,0 +1,72 @@
+const chai = require('chai');
+const chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+const { assert } = chai;
+
+describe('sliced async results', () => {
+  it('ReturnSliced resolves with an array', () =>
+    dll.sequenceSliced(1000).then((r) => {
+      assert.isArray(r);
+      assert.lengthOf(r, 1000);
+      assert.deepStrictEqual(r.slice(0, 3), [0, 1, 2]);
+      assert.strictEqual(r[999], 999);
+    }));
+
+  it('ReturnSliced yields to the event loop', () => {
+    let ticks = 0;
+    let running = true;
+    const tick = () => {
+      ticks++;
+      if (running) setImmediate(tick);
+    };
+    setImmediate(tick);
+    return dll.labelsSliced(2000).then((r) => {
+      running = false;
+      assert.lengthOf(r, 2000);
+      assert.strictEqual(r[1999], 'label1999');
+      assert.isAbove(ticks, 1);
+    });
+  });
+
+  it('ReturnSliced with small and empty results', () =>
+    Promise.all([
+      dll.sequenceSliced(0).then((r) => assert.deepStrictEqual(r, [])),
+      dll.sequenceSliced(3).then((r) => assert.deepStrictEqual(r, [0, 1, 2]))
+    ]));
+
+  it('nested containers are not sliced', () =>
+    dll.triangleSliced(40).then((r) => {
+      assert.lengthOf(r, 40);
+      assert.deepStrictEqual(r[3], [0, 1, 2]);
+      assert.isArray(r[39]);
+    }));
+
+  it('ReturnStreamed resolves with an async iterator', async () => {
+    const it = await dll.sequenceStreamed(100);
+    assert.isFunction(it[Symbol.asyncIterator]);
+    const r = [];
+    for await (const v of it) r.push(v);
+    assert.lengthOf(r, 100);
+    assert.strictEqual(r[99], 99);
+  });
+
+  it('ReturnStreamed keeps the order of concurrent next() calls', async () => {
+    const it = await dll.labelsStreamed(40);
+    const r = await Promise.all(Array.from({ length: 41 }, () => it.next()));
+    assert.strictEqual(r[0].value, 'label0');
+    assert.strictEqual(r[16].value, 'label16');
+    assert.strictEqual(r[39].value, 'label39');
+    assert.isTrue(r[40].done);
+  });
+
+  it('ReturnStreamed early termination', async () => {
+    const it = await dll.sequenceStreamed(100);
+    let n = 0;
+    for await (const v of it) {
+      if (v == 20) break;
+      n++;
+    }
+    assert.strictEqual(n, 20);
+    assert.isTrue((await it.next()).done);
+  });
+});
@@ -0,0 +1,30 @@
+#include <fixtures/strings.h>
+
+#include <nobind.h>
+
+constexpr auto sharedLatin1 = Nobind::ReturnShared | Nobind::ReturnLatin1;
+constexpr auto sharedAsync = Nobind::ReturnShared | Nobind::ReturnAsync;
+constexpr auto internedAsync = Nobind::ReturnInterned | Nobind::ReturnAsync;
+
+NOBIND_MODULE(strings, m) {
+  m.def<&byte_length>("byteLength");
+  m.def<&first_word>("firstWord");
+  m.def<&join>("join");
+  m.def<&to_upper>("toUpper");
+  m.def<&byte_length, Nobind::ReturnAsync>("byteLengthAsync");
+  m.def<&byte_length, Nobind::ReturnDefault, Nobind::ArgLatin1<0>>("byteLengthLatin1");
+  m.def<&echo, Nobind::ReturnLatin1, Nobind::ArgLatin1<0>>("echoLatin1");
+  m.def<&echo, Nobind::ReturnLatin1>("echoUtf8AsLatin1");
+  m.def<&u16_length>("u16Length");
+  m.def<&u16_reverse>("u16Reverse");
+  m.def<&u16_hello>("u16Hello");
+  m.def<&u16_hello, Nobind::ReturnShared>("u16HelloShared");
+  m.def<&description, Nobind::ReturnShared>("description");
+  m.def<&description, sharedLatin1>("descriptionLatin1");
+  m.def<&description_utf8, Nobind::ReturnShared>("descriptionUtf8");
+  m.def<&schema, Nobind::ReturnShared>("schema");
+  m.def<&schema, sharedAsync>("schemaAsync");
+  m.def<&color_name, Nobind::ReturnInterned>("colorName");
+  m.def<&number_name, Nobind::ReturnInterned>("numberName");
+  m.def<&number_name, internedAsync>("numberNameAsync");
+}
@@ -0,0 +1,94 @@
+const { assert } = require('chai');
+
+describe('strings', () => {
+  it('std::string_view', () => {
+    assert.strictEqual(dll.byteLength('nobind17'), 8);
+    assert.strictEqual(dll.byteLength(''), 0);
+    assert.strictEqual(dll.firstWord('hello world'), 'hello');
+  });
+
+  it('const char *', () => {
+    assert.strictEqual(dll.join('hello ', 'world'), 'hello world');
+    assert.strictEqual(dll.toUpper('nobind17'), 'NOBIND17');
+  });
+
+  it('long strings', () => {
+    for (const len of [250, 252, 253, 254, 255, 256, 257, 1000, 65536]) {
+      const ascii = 'a'.repeat(len);
+      assert.strictEqual(dll.byteLength(ascii), len);
+      assert.strictEqual(dll.firstWord(ascii), ascii);
+      assert.strictEqual(dll.join(ascii, ascii), ascii + ascii);
+      // multi-byte characters that do not fit at the end of the inline buffer
+      for (const c of ['é', '€', '😀']) {
+        const s = ascii.substring(0, len - 2) + c;
+        assert.strictEqual(dll.byteLength(s), Buffer.byteLength(s));
+        assert.strictEqual(dll.firstWord(s), s);
+        assert.strictEqual(dll.toUpper(s), ascii.substring(0, len - 2).toUpperCase() + c);
+      }
+    }
+  });
+
+  it('Latin-1', () => {
+    assert.strictEqual(dll.byteLength('café'), 5);
+    assert.strictEqual(dll.byteLengthLatin1('café'), 4);
+    assert.strictEqual(dll.echoLatin1('café ÿ'), 'café ÿ');
+    assert.strictEqual(dll.echoLatin1('é'.repeat(1000)), 'é'.repeat(1000));
+    assert.strictEqual(dll.echoUtf8AsLatin1('café'), 'cafÃ©');
+  });
+
+  it('UTF-16', () => {
+    assert.strictEqual(dll.u16Length('café'), 4);
+    assert.strictEqual(dll.u16Length('😀'), 2);
+    assert.strictEqual(dll.u16Reverse('héllo'), 'olléh');
+    const long = 'ü€'.repeat(5000);
+    assert.strictEqual(dll.u16Length(long), 10000);
+    assert.strictEqual(dll.u16Reverse(dll.u16Reverse(long)), long);
+    assert.strictEqual(dll.u16Hello(), 'héllo wörld');
+  });
+
+  it('shared strings', () => {
+    const description = 'nobind17 is a library for creating Node.js addons from C++ code with very little boilerplate';
+    assert.strictEqual(dll.description(), description);
+    assert.strictEqual(dll.descriptionLatin1(), description);
+    assert.strictEqual(dll.description(), dll.description());
+    assert.strictEqual(dll.descriptionUtf8(), 'nobind17 est une bibliothèque pour créer des addons Node.js');
+    assert.strictEqual(dll.u16HelloShared(), 'héllo wörld');
+    assert.strictEqual(dll.schema(), 'x'.repeat(4096));
+  });
+
+  it('shared strings async', () => dll.schemaAsync()
+    .then((s) => {
+      assert.strictEqual(s, 'x'.repeat(4096));
+    }));
+
+  it('interned strings', () => {
+    for (let i = 0; i < 10; i++) {
+      assert.strictEqual(dll.colorName(i), ['red', 'green', 'blue'][i % 3]);
+    }
+    // more strings than the size of the table
+    for (let i = 0; i < 3000; i++) {
+      assert.strictEqual(dll.numberName(i % 2000), `number ${i % 2000}`);
+    }
+  });
+
+  it('interned strings async', () => dll.numberNameAsync(42)
+    .then((s) => {
+      assert.strictEqual(s, 'number 42');
+    }));
+
+  it('async', () => dll.byteLengthAsync('a'.repeat(300))
+    .then((len) => {
+      assert.strictEqual(len, 300);
+    }));
+
+  it('exception', () => {
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.byteLength(42);
+    }, /Expected a string/);
+    assert.throws(() => {
+      // @ts-expect-error
+      dll.join('a', {});
+    }, /Expected a string/);
+  });
+});